@@ -206,6 +206,8 @@ struct DeployResultDTO {
     int32_t totalCount;                      // 总数
     int32_t successCount;                    // 成功数
     int32_t failureCount;                    // 失败数
+    
+    bool attributed = true;                  // false: 合并调用的结果中没有本请求标签下的业务链路，结果未知
 };
 
 /**
@@ -201,6 +201,30 @@ class AlertService {
         }
     }
 
+    /**
+     * @brief 批量确认告警，返回逐项结果
+     * 
+     * 一次仓储调用（一次写锁）确认全部告警。
+     * 
+     * @param command 包含告警UUID列表的命令
+     * @return 响应DTO，data与alertUUIDs一一对应（告警存在并已确认时为true）
+     */
+    ResponseDTO<std::vector<bool>> AcknowledgeEach(const AlertAcknowledgeDTO& command) const {
+        try {
+            std::vector<bool> acknowledged;
+            size_t count = m_alertRepo->AcknowledgeMultiple(command.alertUUIDs, &acknowledged);
+            
+            return ResponseDTO<std::vector<bool>>::Success(
+                acknowledged,
+                "成功确认 " + std::to_string(count) + " 个告警"
+            );
+        } catch (const std::exception& e) {
+            return ResponseDTO<std::vector<bool>>::Failure(
+                std::string("批量确认告警失败: ") + e.what()
+            );
+        }
+    }
+
     /**
      * @brief 清理过期告警
      * 
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "../../infrastructure/api_client/qyw_api_client.h"
+#include "../../infrastructure/metrics/latency_histogram.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace zygl::application {
+
+/**
+ * @brief DeployCoalescer - 部署/卸载请求合并器
+ *
+ * 后端Deploy/Undeploy接口本身接受标签列表。在一个很短的合并窗口内到达的多个请求
+ * 合并为一次后端调用（标签去重），调用结果由所有参与合并的请求共享，
+ * 再由调用方按各自的标签拆分。
+ *
+ * 合并方式（无额外线程）：
+ * - 窗口内第一个到达的请求成为"领头者"：等待窗口结束（批次提前关闭时立即结束），发起后端调用，然后唤醒其他请求
+ * - 之后到达的请求把标签加入同一批次，等待领头者的调用结果
+ * - 加入后会超过标签数上限时，关闭当前批次并开启新批次（本请求成为新批次的领头者）；
+ *   单个请求本身超过上限时不与其他请求合并
+ *
+ * 合并窗口为0时不合并，每个请求直接调用后端。调用方无法从合并结果中区分本请求的部分时
+ * （如标签下的业务链路尚未采集到），应以exclusive方式提交，单独调用后端。
+ *
+ * 延迟统计：请求延迟（含合并等待）和后端调用延迟分别记录到直方图，
+ * 后端调用超过SLO阈值时输出日志。
+ *
+ * 线程安全：
+ * - Submit()可以被任意线程并发调用（调用线程会阻塞直到后端返回）
+ */
+class DeployCoalescer {
+public:
+    using BackendCall = std::function<std::optional<infrastructure::DeployResponse>(
+        const std::vector<std::string>&)>;
+
+    /**
+     * @brief 一次后端调用的结果（由参与合并的所有请求共享）
+     */
+    struct Outcome {
+        std::optional<infrastructure::DeployResponse> response;    // 后端响应（失败时为空）
+        size_t mergedRequests = 0;                                 // 参与合并的请求数
+    };
+
+    static constexpr size_t MAX_LABELS_PER_CALL = 256;     // 单次后端调用的标签数上限
+
+    /**
+     * @brief 构造函数
+     *
+     * @param operation 操作名称（用于日志，如"Deploy"）
+     * @param call 后端调用
+     */
+    DeployCoalescer(std::string operation, BackendCall call)
+        : m_operation(std::move(operation)),
+          m_call(std::move(call)),
+          m_slo("StackControlService") {
+    }
+
+    // 禁止拷贝
+    DeployCoalescer(const DeployCoalescer&) = delete;
+    DeployCoalescer& operator=(const DeployCoalescer&) = delete;
+
+    /**
+     * @brief 设置合并窗口
+     *
+     * @param window 第一个请求到达后等待其他请求的时间，0表示不合并
+     */
+    void SetWindow(std::chrono::milliseconds window) {
+        m_windowMs.store(window.count() > 0 ? window.count() : 0);
+    }
+
+    /**
+     * @brief 设置后端调用的SLO阈值（0表示不检查）
+     */
+    void SetSlo(std::chrono::milliseconds threshold) {
+        m_slo.SetThreshold(threshold);
+    }
+
+    /**
+     * @brief 提交请求（阻塞直到后端返回）
+     *
+     * @param labels 本请求的标签UUID列表
+     * @param exclusive 为true时不与其他请求合并，结果只对应本请求的标签
+     * @return 后端调用结果（合并时可能包含其他请求的标签对应的业务链路，mergedRequests > 1）
+     */
+    std::shared_ptr<const Outcome> Submit(const std::vector<std::string>& labels, bool exclusive = false) {
+        m_requests.fetch_add(1, std::memory_order_relaxed);
+        auto submittedAt = std::chrono::steady_clock::now();
+        auto outcome = exclusive ? InvokeAlone(labels) : Coalesce(labels);
+        m_requestLatency.Record(std::chrono::steady_clock::now() - submittedAt);
+        return outcome;
+    }
+
+    /**
+     * @brief 获取统计：请求数和实际的后端调用次数
+     */
+    uint64_t GetRequestCount() const { return m_requests.load(std::memory_order_relaxed); }
+    uint64_t GetBackendCallCount() const { return m_backendCalls.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取延迟分布：请求延迟（含合并等待）/ 后端调用延迟
+     */
+    infrastructure::LatencySummary GetRequestLatency() const { return m_requestLatency.GetSummary(); }
+    infrastructure::LatencySummary GetBackendLatency() const { return m_backendLatency.GetSummary(); }
+    uint64_t GetSloBreachCount() const { return m_slo.GetBreachCount(); }
+
+private:
+    /**
+     * @brief 加入合并批次（或直接调用），阻塞直到得到结果
+     */
+    std::shared_ptr<const Outcome> Coalesce(const std::vector<std::string>& labels) {
+        auto window = std::chrono::milliseconds(m_windowMs.load());
+        if (window.count() == 0 || labels.size() > MAX_LABELS_PER_CALL) {
+            return InvokeAlone(labels);
+        }
+
+        std::shared_ptr<Batch> batch;
+        bool leader = false;
+        bool closed = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_openBatch && m_openBatch->labels.size() + CountNewLabels(*m_openBatch, labels) > MAX_LABELS_PER_CALL) {
+                CloseOpenBatch();  // 加入后超过上限：当前批次由其领头者按现有标签立即调用
+                closed = true;
+            }
+            if (!m_openBatch) {
+                m_openBatch = std::make_shared<Batch>();
+                leader = true;
+            }
+            batch = m_openBatch;
+            for (const auto& label : labels) {
+                if (batch->labelSet.insert(label).second) {
+                    batch->labels.push_back(label);
+                }
+            }
+            batch->requests++;
+            if (batch->labels.size() >= MAX_LABELS_PER_CALL) {
+                CloseOpenBatch();  // 批次已满，后续请求开启新批次
+                closed = true;
+            }
+        }
+        if (closed) {
+            m_cv.notify_all();  // 唤醒被关闭批次的领头者，不必等满窗口
+        }
+
+        if (leader) {
+            std::vector<std::string> mergedLabels;
+            size_t mergedRequests = 0;
+            {
+                // 等待窗口结束，或批次提前关闭（已满）
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait_for(lock, window, [&batch]() { return batch->closed; });
+                if (m_openBatch == batch) {
+                    CloseOpenBatch();
+                }
+                mergedLabels = batch->labels;
+                mergedRequests = batch->requests;
+            }
+
+            auto outcome = std::make_shared<Outcome>();
+            outcome->response = Invoke(mergedLabels);
+            outcome->mergedRequests = mergedRequests;
+            m_backendCalls.fetch_add(1, std::memory_order_relaxed);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                batch->outcome = outcome;
+            }
+            m_cv.notify_all();
+            return outcome;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [&batch]() { return batch->outcome != nullptr; });
+        return batch->outcome;
+    }
+
+    /**
+     * @brief 关闭正在收集请求的批次（调用方持有锁）
+     */
+    void CloseOpenBatch() {
+        m_openBatch->closed = true;
+        m_openBatch.reset();
+    }
+
+    /**
+     * @brief 不合并，直接以本请求的标签调用后端
+     */
+    std::shared_ptr<const Outcome> InvokeAlone(const std::vector<std::string>& labels) {
+        auto outcome = std::make_shared<Outcome>();
+        outcome->response = Invoke(labels);
+        outcome->mergedRequests = 1;
+        m_backendCalls.fetch_add(1, std::memory_order_relaxed);
+        return outcome;
+    }
+
+    /**
+     * @brief 调用后端（异常视为失败，保证等待中的请求总能被唤醒），记录调用延迟
+     */
+    std::optional<infrastructure::DeployResponse> Invoke(const std::vector<std::string>& labels) {
+        auto startedAt = std::chrono::steady_clock::now();
+        std::optional<infrastructure::DeployResponse> response;
+        try {
+            response = m_call(labels);
+        } catch (...) {
+            response = std::nullopt;
+        }
+
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startedAt).count();
+        m_backendLatency.Record(static_cast<uint64_t>(micros));
+        m_slo.Check(m_operation.c_str(), static_cast<uint64_t>(micros));
+        return response;
+    }
+
+    struct Batch {
+        std::vector<std::string> labels;            // 合并后的标签（去重，保持到达顺序）
+        std::unordered_set<std::string> labelSet;   // 用于去重
+        size_t requests = 0;                        // 参与合并的请求数
+        bool closed = false;                        // 不再接受新请求（窗口结束或已满）
+        std::shared_ptr<const Outcome> outcome;     // 后端调用结果（领头者写入）
+    };
+
+    /**
+     * @brief 统计请求中尚未在批次里的标签数（调用方持有锁）
+     */
+    static size_t CountNewLabels(const Batch& batch, const std::vector<std::string>& labels) {
+        std::unordered_set<std::string> seen;
+        size_t count = 0;
+        for (const auto& label : labels) {
+            if (batch.labelSet.count(label) == 0 && seen.insert(label).second) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    std::string m_operation;
+    BackendCall m_call;
+    std::atomic<int64_t> m_windowMs{0};
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::shared_ptr<Batch> m_openBatch;             // 正在收集请求的批次
+
+    std::atomic<uint64_t> m_requests{0};
+    std::atomic<uint64_t> m_backendCalls{0};
+
+    infrastructure::LatencyHistogram m_requestLatency;      // 请求延迟（含合并等待）
+    infrastructure::LatencyHistogram m_backendLatency;      // 后端调用延迟
+    infrastructure::SloMonitor m_slo;                       // 后端调用SLO
+};
+
+} // namespace zygl::application
@@ -3,6 +3,7 @@
 #include "../../domain/i_chassis_repository.h"
 #include "../../domain/i_stack_repository.h"
 #include "../../domain/i_alert_repository.h"
+#include "../../infrastructure/collectors/collect_cycle_stats.h"
 #include "../dtos/dtos.h"
 #include <memory>
 #include <optional>
@@ -17,7 +18,8 @@ namespace zygl::application {
  * 1. 提供系统状态查询（机箱、板卡、任务）
  * 2. 提供业务链路信息查询
  * 3. 提供告警信息查询
- * 4. 将领域对象转换为DTOs
+ * 4. 提供数据采集周期统计查询（各阶段耗时、字节数、变化数、失败原因）
+ * 5. 将领域对象转换为DTOs
  * 
  * 这是一个只读服务，不修改数据。
  */
@@ -35,8 +37,41 @@ class MonitoringService {
           m_alertRepo(alertRepo) {
     }
 
+    /**
+     * @brief 设置采集周期记录环（由数据采集服务提供，启动时设置一次）
+     */
+    void SetCollectionStats(std::shared_ptr<const infrastructure::CollectCycleHistory> history) {
+        m_collectionStats = std::move(history);
+    }
+
     // ==================== 机箱和板卡查询 ====================
 
+    /**
+     * @brief 获取机箱快照版本号
+     * 
+     * 机箱仓储每次提交新数据后递增。接口层可以据此缓存编码后的状态报文，
+     * 版本号不变时直接复用。应在读取数据之前获取版本号。
+     * 
+     * @return 快照版本号
+     */
+    uint64_t GetChassisSnapshotVersion() const {
+        return m_chassisRepo->GetVersion();
+    }
+
+    /**
+     * @brief 获取业务链路数据版本号（用法同GetChassisSnapshotVersion）
+     */
+    uint64_t GetStacksVersion() const {
+        return m_stackRepo->GetVersion();
+    }
+
+    /**
+     * @brief 获取告警数据版本号（用法同GetChassisSnapshotVersion）
+     */
+    uint64_t GetAlertsVersion() const {
+        return m_alertRepo->GetVersion();
+    }
+
     /**
      * @brief 获取系统概览
      * 
@@ -217,6 +252,22 @@ class MonitoringService {
         }
     }
 
+    /**
+     * @brief 按位置查找任务（机箱号/板卡号/任务序号）
+     * 
+     * 用于UDP任务查看（F005H）的热路径：直接返回定长视图，
+     * 常数时间且不分配内存，因此不经过ResponseDTO。
+     * 
+     * @param chassisNumber 机箱号（1-9）
+     * @param boardNumber 板卡槽位号（1-14）
+     * @param taskIndex 任务序号（1-8）
+     * @return 任务槽位视图，位置无效或无任务时返回std::nullopt
+     */
+    std::optional<domain::TaskSlotView> FindTaskAt(
+        int32_t chassisNumber, int32_t boardNumber, int32_t taskIndex) const {
+        return m_stackRepo->FindTaskAt(chassisNumber, boardNumber, taskIndex);
+    }
+
     // ==================== 告警查询 ====================
 
     /**
@@ -287,6 +338,34 @@ class MonitoringService {
         }
     }
 
+    // ==================== 采集统计查询 ====================
+
+    /**
+     * @brief 获取最近N个采集周期的汇总（各阶段最小值/平均值/99分位、失败次数）
+     * 
+     * @return 汇总，未设置采集周期记录环时失败
+     */
+    ResponseDTO<infrastructure::CollectCycleSummary> GetCollectionSummary() const {
+        if (!m_collectionStats) {
+            return ResponseDTO<infrastructure::CollectCycleSummary>::Failure("未启用数据采集统计");
+        }
+        return ResponseDTO<infrastructure::CollectCycleSummary>::Success(m_collectionStats->GetSummary());
+    }
+
+    /**
+     * @brief 获取最近的采集周期明细（从旧到新）
+     * 
+     * @param maxCount 最多返回的周期数，0表示全部
+     * @return 周期记录列表，未设置采集周期记录环时失败
+     */
+    ResponseDTO<std::vector<infrastructure::CollectCycleRecord>> GetRecentCollectionCycles(size_t maxCount = 0) const {
+        if (!m_collectionStats) {
+            return ResponseDTO<std::vector<infrastructure::CollectCycleRecord>>::Failure("未启用数据采集统计");
+        }
+        return ResponseDTO<std::vector<infrastructure::CollectCycleRecord>>::Success(
+            m_collectionStats->GetRecent(maxCount));
+    }
+
 private:
     // ==================== 转换方法 ====================
 
@@ -445,6 +524,7 @@ class MonitoringService {
     std::shared_ptr<domain::IChassisRepository> m_chassisRepo;
     std::shared_ptr<domain::IStackRepository> m_stackRepo;
     std::shared_ptr<domain::IAlertRepository> m_alertRepo;
+    std::shared_ptr<const infrastructure::CollectCycleHistory> m_collectionStats;     // 采集周期记录（可选）
 };
 
 } // namespace zygl::application
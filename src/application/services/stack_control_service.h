@@ -3,9 +3,17 @@
 #include "../../domain/i_stack_repository.h"
 #include "../../infrastructure/api_client/qyw_api_client.h"
 #include "../dtos/dtos.h"
+#include "deploy_coalescer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
 #include <memory>
+#include <system_error>
 #include <vector>
 #include <string>
+#include <unordered_set>
 
 namespace zygl::application {
 
@@ -19,6 +27,9 @@ namespace zygl::application {
  * 4. 返回操作结果
  * 
  * 这是一个写服务，会调用外部API修改系统状态。
+ * 
+ * 并发到达的Deploy（或Undeploy）请求可以在一个短窗口内合并为一次后端调用
+ * （SetCoalescingWindow），以减少批量操作时的后端压力。
  */
 class StackControlService {
 public:
@@ -29,127 +40,119 @@ class StackControlService {
         std::shared_ptr<domain::IStackRepository> stackRepo,
         std::shared_ptr<infrastructure::QywApiClient> apiClient)
         : m_stackRepo(stackRepo),
-          m_apiClient(apiClient) {
+          m_apiClient(apiClient),
+          m_deployCoalescer(std::make_unique<DeployCoalescer>(
+              "Deploy", [apiClient](const std::vector<std::string>& labels) { return apiClient->Deploy(labels); })),
+          m_undeployCoalescer(std::make_unique<DeployCoalescer>(
+              "Undeploy", [apiClient](const std::vector<std::string>& labels) { return apiClient->Undeploy(labels); })) {
+    }
+
+    /**
+     * @brief 设置部署/卸载请求的合并窗口
+     * 
+     * 窗口内并发到达的多个请求合并为一次后端调用，结果再按各自的标签拆分。
+     * 
+     * @param window 合并窗口，0表示不合并（每个请求单独调用后端）
+     */
+    void SetCoalescingWindow(std::chrono::milliseconds window) {
+        m_deployCoalescer->SetWindow(window);
+        m_undeployCoalescer->SetWindow(window);
+    }
+
+    /**
+     * @brief 获取后端调用统计（请求数 / 实际调用数，用于观察合并效果）
+     */
+    uint64_t GetDeployRequestCount() const { return m_deployCoalescer->GetRequestCount(); }
+    uint64_t GetDeployBackendCallCount() const { return m_deployCoalescer->GetBackendCallCount(); }
+    uint64_t GetUndeployRequestCount() const { return m_undeployCoalescer->GetRequestCount(); }
+    uint64_t GetUndeployBackendCallCount() const { return m_undeployCoalescer->GetBackendCallCount(); }
+
+    /**
+     * @brief 设置后端调用的SLO阈值，超过时输出日志
+     * 
+     * @param threshold 阈值，0表示不检查
+     */
+    void SetBackendSlo(std::chrono::milliseconds threshold) {
+        m_deployCoalescer->SetSlo(threshold);
+        m_undeployCoalescer->SetSlo(threshold);
+    }
+
+    /**
+     * @brief 获取延迟分布：请求延迟（含合并等待）/ 后端调用延迟
+     */
+    infrastructure::LatencySummary GetDeployLatency() const { return m_deployCoalescer->GetRequestLatency(); }
+    infrastructure::LatencySummary GetDeployBackendLatency() const { return m_deployCoalescer->GetBackendLatency(); }
+    infrastructure::LatencySummary GetUndeployLatency() const { return m_undeployCoalescer->GetRequestLatency(); }
+    infrastructure::LatencySummary GetUndeployBackendLatency() const { return m_undeployCoalescer->GetBackendLatency(); }
+
+    /**
+     * @brief 获取后端调用超过SLO阈值的次数
+     */
+    uint64_t GetBackendSloBreachCount() const {
+        return m_deployCoalescer->GetSloBreachCount() + m_undeployCoalescer->GetSloBreachCount();
+    }
+
+    /**
+     * @brief 设置后端状态变化监听器
+     * 
+     * 后端接受部署/卸载调用（返回了响应）后调用，用于让数据采集尽快刷新业务链路状态。
+     * 监听器在命令执行线程中同步执行，应尽快返回；应在开始处理命令之前设置。
+     */
+    void SetBackendChangeListener(std::function<void()> listener) {
+        m_backendChangeListener = std::move(listener);
     }
 
     /**
      * @brief 根据标签批量启用业务链路
      * 
      * 工作流程：
-     * 1. 从仓储中查找包含指定标签的业务链路
+     * 1. 与合并窗口内的其他Deploy请求合并
      * 2. 调用后端API执行Deploy操作
-     * 3. 返回操作结果（成功和失败的业务链路列表）
+     * 3. 返回本请求标签对应的操作结果（成功和失败的业务链路列表）
      * 
      * @param command 包含标签UUID列表的命令
      * @return 部署结果DTO
      */
     ResponseDTO<DeployResultDTO> DeployByLabels(const DeployCommandDTO& command) const {
-        try {
-            // 验证输入
-            if (command.stackLabels.empty()) {
-                return ResponseDTO<DeployResultDTO>::Failure("标签列表不能为空");
-            }
-            
-            // 调用后端API执行Deploy
-            auto deployResponseOpt = m_apiClient->Deploy(command.stackLabels);
-            if (!deployResponseOpt.has_value()) {
-                return ResponseDTO<DeployResultDTO>::Failure("调用后端API失败");
-            }
-            
-            const auto& apiResponse = deployResponseOpt.value();
-            
-            // 转换为DTO
-            DeployResultDTO result;
-            
-            // 成功的业务链路
-            for (const auto& success : apiResponse.successStackInfos) {
-                DeployResultDTO::StackResult stackResult;
-                stackResult.stackName = success.stackName;
-                stackResult.stackUUID = success.stackUUID;
-                stackResult.message = success.message;
-                result.successStacks.push_back(stackResult);
-            }
-            
-            // 失败的业务链路
-            for (const auto& failure : apiResponse.failureStackInfos) {
-                DeployResultDTO::StackResult stackResult;
-                stackResult.stackName = failure.stackName;
-                stackResult.stackUUID = failure.stackUUID;
-                stackResult.message = failure.message;
-                result.failureStacks.push_back(stackResult);
-            }
-            
-            // 统计
-            result.totalCount = static_cast<int32_t>(result.successStacks.size() + result.failureStacks.size());
-            result.successCount = static_cast<int32_t>(result.successStacks.size());
-            result.failureCount = static_cast<int32_t>(result.failureStacks.size());
-            
-            return ResponseDTO<DeployResultDTO>::Success(result, "Deploy命令执行完成");
-        } catch (const std::exception& e) {
-            return ResponseDTO<DeployResultDTO>::Failure(
-                std::string("执行Deploy命令失败: ") + e.what()
-            );
-        }
+        return ExecuteByLabels(command, *m_deployCoalescer, "Deploy");
     }
 
     /**
      * @brief 根据标签批量停用业务链路
      * 
      * 工作流程：
-     * 1. 从仓储中查找包含指定标签的业务链路
+     * 1. 与合并窗口内的其他Undeploy请求合并
      * 2. 调用后端API执行Undeploy操作
-     * 3. 返回操作结果（成功和失败的业务链路列表）
+     * 3. 返回本请求标签对应的操作结果（成功和失败的业务链路列表）
      * 
      * @param command 包含标签UUID列表的命令
      * @return 部署结果DTO
      */
     ResponseDTO<DeployResultDTO> UndeployByLabels(const DeployCommandDTO& command) const {
-        try {
-            // 验证输入
-            if (command.stackLabels.empty()) {
-                return ResponseDTO<DeployResultDTO>::Failure("标签列表不能为空");
-            }
-            
-            // 调用后端API执行Undeploy
-            auto undeployResponseOpt = m_apiClient->Undeploy(command.stackLabels);
-            if (!undeployResponseOpt.has_value()) {
-                return ResponseDTO<DeployResultDTO>::Failure("调用后端API失败");
-            }
-            
-            const auto& apiResponse = undeployResponseOpt.value();
-            
-            // 转换为DTO
-            DeployResultDTO result;
-            
-            // 成功的业务链路
-            for (const auto& success : apiResponse.successStackInfos) {
-                DeployResultDTO::StackResult stackResult;
-                stackResult.stackName = success.stackName;
-                stackResult.stackUUID = success.stackUUID;
-                stackResult.message = success.message;
-                result.successStacks.push_back(stackResult);
-            }
-            
-            // 失败的业务链路
-            for (const auto& failure : apiResponse.failureStackInfos) {
-                DeployResultDTO::StackResult stackResult;
-                stackResult.stackName = failure.stackName;
-                stackResult.stackUUID = failure.stackUUID;
-                stackResult.message = failure.message;
-                result.failureStacks.push_back(stackResult);
-            }
-            
-            // 统计
-            result.totalCount = static_cast<int32_t>(result.successStacks.size() + result.failureStacks.size());
-            result.successCount = static_cast<int32_t>(result.successStacks.size());
-            result.failureCount = static_cast<int32_t>(result.failureStacks.size());
-            
-            return ResponseDTO<DeployResultDTO>::Success(result, "Undeploy命令执行完成");
-        } catch (const std::exception& e) {
-            return ResponseDTO<DeployResultDTO>::Failure(
-                std::string("执行Undeploy命令失败: ") + e.what()
-            );
-        }
+        return ExecuteByLabels(command, *m_undeployCoalescer, "Undeploy");
+    }
+
+    /**
+     * @brief 一次后端调用启用多个标签，返回每个标签各自的结果
+     * 
+     * 能在仓储中找到业务链路的标签经合并器一次提交，结果按各标签下的业务链路拆分；
+     * 找不到业务链路的标签无法拆分，各自单独调用后端（并发，最多MAX_EXCLUSIVE_CALLS个同时进行）。
+     * 
+     * @param labels 标签UUID列表
+     * @return 与labels一一对应的结果
+     */
+    std::vector<ResponseDTO<DeployResultDTO>> DeployEachLabel(const std::vector<std::string>& labels) const {
+        return ExecuteEachLabel(labels, *m_deployCoalescer, "Deploy");
+    }
+
+    /**
+     * @brief 一次后端调用停用多个标签，返回每个标签各自的结果
+     * 
+     * @param labels 标签UUID列表
+     * @return 与labels一一对应的结果
+     */
+    std::vector<ResponseDTO<DeployResultDTO>> UndeployEachLabel(const std::vector<std::string>& labels) const {
+        return ExecuteEachLabel(labels, *m_undeployCoalescer, "Undeploy");
     }
 
     /**
@@ -205,8 +208,204 @@ class StackControlService {
     }
 
 private:
+    /**
+     * @brief 执行Deploy/Undeploy（经合并器调用后端）
+     * 
+     * @param command 包含标签UUID列表的命令
+     * @param coalescer 对应操作的合并器
+     * @param operation 操作名称（用于消息）
+     */
+    ResponseDTO<DeployResultDTO> ExecuteByLabels(const DeployCommandDTO& command,
+                                                 DeployCoalescer& coalescer,
+                                                 const std::string& operation) const {
+        try {
+            // 验证输入
+            if (command.stackLabels.empty()) {
+                return ResponseDTO<DeployResultDTO>::Failure("标签列表不能为空");
+            }
+            
+            // 调用后端API：标签都能找到业务链路时可与其他请求合并，否则单独调用
+            std::unordered_set<std::string> ownStacks;
+            bool resolved = CollectStacksByLabels(command.stackLabels, ownStacks);
+            auto outcome = coalescer.Submit(command.stackLabels, !resolved);
+            if (!outcome->response.has_value()) {
+                return ResponseDTO<DeployResultDTO>::Failure("调用后端API失败");
+            }
+            NotifyBackendChanged();
+            
+            // 合并调用时只保留本请求标签下的业务链路
+            bool filter = outcome->mergedRequests > 1;
+            return ResponseDTO<DeployResultDTO>::Success(
+                BuildResult(outcome->response.value(), filter ? &ownStacks : nullptr),
+                operation + "命令执行完成");
+        } catch (const std::exception& e) {
+            return ResponseDTO<DeployResultDTO>::Failure(
+                "执行" + operation + "命令失败: " + e.what()
+            );
+        }
+    }
+
+    /**
+     * @brief 一次提交多个标签，按标签拆分结果
+     * 
+     * 找不到业务链路的标签无法从共享的结果中拆分，各自单独提交，其结果只对应该标签。
+     * 单独提交的调用与共享调用并发进行（辅助线程数有上限），总耗时约为最慢的一次调用，
+     * 而不是所有调用之和，避免长时间占用执行线程。
+     */
+    std::vector<ResponseDTO<DeployResultDTO>> ExecuteEachLabel(const std::vector<std::string>& labels,
+                                                               DeployCoalescer& coalescer,
+                                                               const std::string& operation) const {
+        std::vector<ResponseDTO<DeployResultDTO>> results;
+        if (labels.empty()) {
+            return results;
+        }
+
+        try {
+            std::vector<std::unordered_set<std::string>> ownStacks(labels.size());
+            std::vector<std::string> shared;
+            for (size_t i = 0; i < labels.size(); ++i) {
+                if (CollectStacksByLabels({labels[i]}, ownStacks[i])) {
+                    shared.push_back(labels[i]);
+                }
+            }
+
+            // 无法拆分的标签：辅助线程和当前线程从同一个队列中取标签，各自单独提交
+            std::vector<size_t> exclusive;
+            for (size_t i = 0; i < labels.size(); ++i) {
+                if (ownStacks[i].empty()) {
+                    exclusive.push_back(i);
+                }
+            }
+            std::vector<std::shared_ptr<const DeployCoalescer::Outcome>> exclusiveOutcomes(labels.size());
+            std::atomic<size_t> nextExclusive{0};
+            auto submitExclusive = [&]() {
+                for (size_t k; (k = nextExclusive.fetch_add(1)) < exclusive.size();) {
+                    size_t i = exclusive[k];
+                    exclusiveOutcomes[i] = coalescer.Submit({labels[i]}, true);
+                }
+            };
+            std::vector<std::future<void>> helpers;
+            size_t helperCount = std::min(MAX_EXCLUSIVE_CALLS, exclusive.size());
+            for (size_t h = 0; h < helperCount; ++h) {
+                try {
+                    helpers.push_back(std::async(std::launch::async, submitExclusive));
+                } catch (const std::system_error&) {
+                    break;  // 无法创建线程时由当前线程完成剩余的提交
+                }
+            }
+
+            std::shared_ptr<const DeployCoalescer::Outcome> sharedOutcome;
+            bool split = false;
+            if (!shared.empty()) {
+                sharedOutcome = coalescer.Submit(shared);
+                split = shared.size() > 1 || sharedOutcome->mergedRequests > 1;
+            }
+            submitExclusive();
+            for (auto& helper : helpers) {
+                helper.get();
+            }
+            
+            bool changed = false;
+            for (size_t i = 0; i < labels.size(); ++i) {
+                bool resolved = !ownStacks[i].empty();
+                const auto& outcome = resolved ? sharedOutcome : exclusiveOutcomes[i];
+                if (!outcome->response.has_value()) {
+                    results.push_back(ResponseDTO<DeployResultDTO>::Failure("调用后端API失败"));
+                    continue;
+                }
+                changed = true;
+                
+                bool filter = resolved && split;
+                results.push_back(ResponseDTO<DeployResultDTO>::Success(
+                    BuildResult(outcome->response.value(), filter ? &ownStacks[i] : nullptr),
+                    operation + "命令执行完成"));
+            }
+            if (changed) {
+                NotifyBackendChanged();
+            }
+        } catch (const std::exception& e) {
+            results.assign(labels.size(), ResponseDTO<DeployResultDTO>::Failure(
+                "执行" + operation + "命令失败: " + e.what()));
+        }
+        return results;
+    }
+
+    static constexpr size_t MAX_EXCLUSIVE_CALLS = 4;   // 单独提交的后端调用的辅助线程数上限
+
+    void NotifyBackendChanged() const {
+        if (m_backendChangeListener) {
+            m_backendChangeListener();
+        }
+    }
+
+    /**
+     * @brief 将后端响应转换为DTO
+     * 
+     * @param ownStacks 非空时只保留其中的业务链路
+     */
+    static DeployResultDTO BuildResult(const infrastructure::DeployResponse& apiResponse,
+                                       const std::unordered_set<std::string>* ownStacks) {
+        DeployResultDTO result;
+        bool filter = ownStacks != nullptr;
+        
+        // 成功的业务链路
+        for (const auto& success : apiResponse.successStackInfos) {
+            if (filter && ownStacks->count(success.stackUUID) == 0) {
+                continue;
+            }
+            DeployResultDTO::StackResult stackResult;
+            stackResult.stackName = success.stackName;
+            stackResult.stackUUID = success.stackUUID;
+            stackResult.message = success.message;
+            result.successStacks.push_back(stackResult);
+        }
+        
+        // 失败的业务链路
+        for (const auto& failure : apiResponse.failureStackInfos) {
+            if (filter && ownStacks->count(failure.stackUUID) == 0) {
+                continue;
+            }
+            DeployResultDTO::StackResult stackResult;
+            stackResult.stackName = failure.stackName;
+            stackResult.stackUUID = failure.stackUUID;
+            stackResult.message = failure.message;
+            result.failureStacks.push_back(stackResult);
+        }
+        
+        // 统计
+        result.totalCount = static_cast<int32_t>(result.successStacks.size() + result.failureStacks.size());
+        result.successCount = static_cast<int32_t>(result.successStacks.size());
+        result.failureCount = static_cast<int32_t>(result.failureStacks.size());
+        result.attributed = !filter || result.totalCount > 0;
+        return result;
+    }
+
+    /**
+     * @brief 查找标签下的业务链路UUID（用于拆分合并调用的结果）
+     * 
+     * @return false 如果某个标签在仓储中找不到业务链路（无法拆分，需单独调用后端）
+     */
+    bool CollectStacksByLabels(const std::vector<std::string>& labels,
+                               std::unordered_set<std::string>& stackUUIDs) const {
+        bool resolved = true;
+        for (const auto& label : labels) {
+            auto stacks = m_stackRepo->FindByLabel(label);
+            resolved = resolved && !stacks.empty();
+            for (const auto& stack : stacks) {
+                stackUUIDs.insert(stack.GetStackUUID());
+            }
+        }
+        return resolved;
+    }
+
     std::shared_ptr<domain::IStackRepository> m_stackRepo;
     std::shared_ptr<infrastructure::QywApiClient> m_apiClient;
+    
+    // 请求合并器（Deploy和Undeploy分别合并）
+    std::unique_ptr<DeployCoalescer> m_deployCoalescer;
+    std::unique_ptr<DeployCoalescer> m_undeployCoalescer;
+    
+    std::function<void()> m_backendChangeListener;     // 部署/卸载被后端接受后通知
 };
 
 } // namespace zygl::application
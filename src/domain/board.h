@@ -140,6 +140,21 @@ class Board {
         }
     }
 
+    /**
+     * @brief 将离线（或未知）板卡标记为在线
+     * 
+     * 收到后端推送的板卡上线通知时调用。上线时尚无任务信息，
+     * 状态先按正常处理，任务列表和实际状态由下一次数据采集更新。
+     * 已在线的板卡保持不变。
+     */
+    void MarkAsOnline() {
+        if (IsOnline()) {
+            return;
+        }
+        m_status = BoardOperationalStatus::Normal;
+        m_taskCount = 0;
+    }
+
     /**
      * @brief 设置板卡地址
      */
@@ -23,6 +23,7 @@
 #include "alert.h"
 
 // 仓储接口
+#include "repository_change_listener.h"
 #include "i_chassis_repository.h"
 #include "i_stack_repository.h"
 #include "i_alert_repository.h"
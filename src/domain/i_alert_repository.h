@@ -1,6 +1,7 @@
 #pragma once
 
 #include "alert.h"
+#include "repository_change_listener.h"
 #include <memory>
 #include <vector>
 #include <optional>
@@ -97,12 +98,14 @@ class IAlertRepository {
     virtual bool Acknowledge(const std::string& alertUUID) = 0;
 
     /**
-     * @brief 批量确认多个告警
+     * @brief 批量确认多个告警（一次获取写锁，一次版本递增和变更通知）
      * 
      * @param alertUUIDs 告警UUID列表
+     * @param acknowledged 可选输出：与alertUUIDs一一对应，告警存在并已确认时为true
      * @return 成功确认的告警数量
      */
-    virtual size_t AcknowledgeMultiple(const std::vector<std::string>& alertUUIDs) = 0;
+    virtual size_t AcknowledgeMultiple(const std::vector<std::string>& alertUUIDs,
+                                       std::vector<bool>* acknowledged = nullptr) = 0;
 
     /**
      * @brief 移除一个告警
@@ -148,6 +151,24 @@ class IAlertRepository {
      * @brief 获取组件告警数量
      */
     virtual size_t CountComponentAlerts() const = 0;
+
+    /**
+     * @brief 注册变更监听器
+     * 
+     * 新增、确认、移除告警后调用（无实际变化时不调用）。
+     * 
+     * @param listener 监听器
+     */
+    virtual void AddChangeListener(RepositoryChangeListener listener) = 0;
+
+    /**
+     * @brief 获取当前数据版本号
+     * 
+     * 每次新增、确认、移除告警提交后递增，用于缓存编码结果。
+     * 
+     * @return 版本号（单调递增）
+     */
+    virtual uint64_t GetVersion() const = 0;
 };
 
 } // namespace zygl::domain
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "chassis.h"
+#include "repository_change_listener.h"
 #include <memory>
 #include <vector>
 #include <optional>
@@ -103,6 +104,24 @@ class IChassisRepository {
      * @param initialChassis 初始的9个机箱（由ChassisFactory创建）
      */
     virtual void Initialize(const std::array<Chassis, TOTAL_CHASSIS_COUNT>& initialChassis) = 0;
+
+    /**
+     * @brief 注册变更监听器
+     * 
+     * 每次SaveAll()/Initialize()提交新数据后调用。
+     * 
+     * @param listener 监听器
+     */
+    virtual void AddChangeListener(RepositoryChangeListener listener) = 0;
+
+    /**
+     * @brief 获取当前快照版本号
+     * 
+     * 每次SaveAll()/Initialize()提交后递增，用于缓存编码结果。
+     * 
+     * @return 版本号（单调递增）
+     */
+    virtual uint64_t GetVersion() const = 0;
 };
 
 } // namespace zygl::domain
@@ -1,10 +1,14 @@
 #pragma once
 
 #include "stack.h"
+#include "chassis.h"
+#include "i_chassis_repository.h"
+#include "repository_change_listener.h"
 #include <memory>
 #include <vector>
 #include <optional>
 #include <string>
+#include <array>
 
 namespace zygl::domain {
 
@@ -84,6 +88,28 @@ class IStackRepository {
      */
     virtual std::optional<Stack> FindStackByTaskID(const std::string& taskID) const = 0;
 
+    /**
+     * @brief 更新任务的物理位置（机箱/板卡/任务序号 -> 任务ID）
+     * 
+     * 由DataCollector在提交boardinfo后调用。实现类据此维护位置索引，
+     * 使FindTaskAt()为常数时间。任务序号即任务在板卡任务列表中的顺序，
+     * 与资源监控报文（F000H）中的任务状态位置一致。
+     * 
+     * @param allChassis 所有9个机箱（包含每块板卡上的任务列表）
+     */
+    virtual void UpdateTaskPlacement(const std::array<Chassis, TOTAL_CHASSIS_COUNT>& allChassis) = 0;
+
+    /**
+     * @brief 按位置查找任务（常数时间，不分配内存）
+     * 
+     * @param chassisNumber 机箱号（1-9）
+     * @param boardNumber 板卡槽位号（1-14）
+     * @param taskIndex 任务序号（1-8）
+     * @return 任务槽位视图，如果位置无效或该位置没有任务返回std::nullopt
+     */
+    virtual std::optional<TaskSlotView> FindTaskAt(
+        int32_t chassisNumber, int32_t boardNumber, int32_t taskIndex) const = 0;
+
     /**
      * @brief 移除一个业务链路
      * 
@@ -123,6 +149,24 @@ class IStackRepository {
      * @brief 统计所有业务链路中的任务总数
      */
     virtual size_t CountTotalTasks() const = 0;
+
+    /**
+     * @brief 注册变更监听器
+     * 
+     * 每次Save()/SaveAll()/Remove()/Clear()提交后调用。
+     * 
+     * @param listener 监听器
+     */
+    virtual void AddChangeListener(RepositoryChangeListener listener) = 0;
+
+    /**
+     * @brief 获取当前数据版本号
+     * 
+     * 每次Save()/SaveAll()/Remove()/Clear()提交后递增，用于缓存编码结果。
+     * 
+     * @return 版本号（单调递增）
+     */
+    virtual uint64_t GetVersion() const = 0;
 };
 
 } // namespace zygl::domain
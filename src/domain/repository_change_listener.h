@@ -0,0 +1,19 @@
+#pragma once
+
+#include <functional>
+
+namespace zygl::domain {
+
+/**
+ * @brief 仓储变更监听器
+ * 
+ * 仓储在写操作提交后（释放写锁之后）调用已注册的监听器，
+ * 用于让接口层（如UDP状态广播）在数据变化时立即推送，而不必轮询。
+ * 
+ * 注意：
+ * - 监听器在写入者线程中同步执行，应尽快返回（通常只是唤醒另一个线程）
+ * - 监听器内不得再向同一仓储注册监听器
+ */
+using RepositoryChangeListener = std::function<void()>;
+
+} // namespace zygl::domain
@@ -73,6 +73,11 @@ class Service {
         m_tasks[task.GetTaskID()] = task;
     }
 
+    void AddOrUpdateTask(Task&& task) {
+        std::string taskID = task.GetTaskID();
+        m_tasks.insert_or_assign(std::move(taskID), std::move(task));
+    }
+
     /**
      * @brief 根据任务ID查找任务
      * @param taskID 任务ID
@@ -87,6 +87,11 @@ class Stack {
         m_services[service.GetServiceUUID()] = service;
     }
 
+    void AddOrUpdateService(Service&& service) {
+        std::string serviceUUID = service.GetServiceUUID();
+        m_services.insert_or_assign(std::move(serviceUUID), std::move(service));
+    }
+
     /**
      * @brief 根据组件UUID查找组件
      * @param serviceUUID 组件UUID
@@ -166,6 +166,15 @@ struct ResourceUsage {
     }
 };
 
+// 任务槽位视图（按机箱号/板卡号/任务序号定位的任务信息，定长，查询时不分配内存）
+struct TaskSlotView {
+    char taskID[64] = {};           // 任务ID
+    char taskStatus[32] = {};       // 任务状态（来自boardinfo）
+    char boardAddress[16] = {};     // 板卡IP地址（IPv4）
+    ResourceUsage resources;        // 资源使用情况（来自stackinfo，构造时清零）
+    bool hasResources = false;      // stackinfo中是否找到该任务
+};
+
 // 告警消息
 struct AlertMessage {
     char message[256];          // 告警消息内容
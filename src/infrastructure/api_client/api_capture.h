@@ -0,0 +1,224 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace zygl::infrastructure {
+
+/**
+ * @brief 抓取的一条后端响应
+ */
+struct CapturedResponse {
+    int64_t capturedAtUs = 0;   // 请求开始时间（Unix微秒）
+    int64_t durationUs = 0;     // 请求到收完响应体的耗时
+    int status = 0;             // HTTP状态码
+    std::string path;           // 请求路径（如 /api/v1/external/qyw/stackinfo）
+    std::string body;           // 解压后的原始响应体
+};
+
+/**
+ * @brief 抓取统计快照
+ */
+struct ApiCaptureStats {
+    bool active = false;            // 是否正在抓取
+    uint64_t records = 0;           // 已写入的响应数
+    uint64_t bytes = 0;             // 已写入的字节数（含记录头）
+    uint64_t segments = 0;          // 已创建的分段文件数
+    uint64_t writeFailures = 0;     // 写入失败次数
+};
+
+/**
+ * @brief 抓取分段文件格式
+ *
+ * 每个分段文件以一行文件头开始，之后是连续的记录；记录头为一行文本，
+ * 响应体按原样写入（不转义），便于用文本工具查看，也便于按长度跳过：
+ *
+ *     ZYGLCAP 1
+ *     <capturedAtUs> <durationUs> <status> <path> <length>
+ *     <length字节的响应体>
+ *     ...
+ *
+ * 路径不含空格；响应体之后紧跟一个换行。
+ */
+namespace api_capture_format {
+    constexpr const char* MAGIC = "ZYGLCAP 1";
+}
+
+/**
+ * @brief ApiCaptureWriter - 将后端响应按时间顺序写入分段文件
+ *
+ * 文件名为 <前缀>-<序号>.cap（序号6位，从000001开始），当前分段超过分段大小后
+ * 在下一条记录之前换新文件，便于按时间段截取、拷贝或删除。
+ * 目录需要事先存在。写入失败时记录次数并继续（不影响采集）。
+ *
+ * 线程安全：
+ * - Write()可以被多个线程并发调用（boardinfo/stackinfo并发拉取），记录按写入顺序排列
+ */
+class ApiCaptureWriter {
+public:
+    static constexpr size_t DEFAULT_SEGMENT_BYTES = 64 * 1024 * 1024;  // 默认每个分段64MB
+
+    /**
+     * @brief 构造函数
+     *
+     * @param pathPrefix 分段文件路径前缀（如 "capture/qyw"）
+     * @param segmentBytes 分段大小，0时使用默认值
+     */
+    ApiCaptureWriter(std::string pathPrefix, size_t segmentBytes)
+        : m_pathPrefix(std::move(pathPrefix)),
+          m_segmentBytes(segmentBytes > 0 ? segmentBytes : DEFAULT_SEGMENT_BYTES) {
+    }
+
+    // 禁止拷贝
+    ApiCaptureWriter(const ApiCaptureWriter&) = delete;
+    ApiCaptureWriter& operator=(const ApiCaptureWriter&) = delete;
+
+    /**
+     * @brief 打开第一个分段（StartCapture时调用，用于立即报告路径错误）
+     */
+    bool Open() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return OpenSegment();
+    }
+
+    /**
+     * @brief 写入一条响应（字段含义见CapturedResponse，响应体不复制）
+     */
+    void Write(int64_t capturedAtUs, int64_t durationUs, int status,
+               const std::string& path, const std::string& body) {
+        std::ostringstream header;
+        header << capturedAtUs << ' ' << durationUs << ' ' << status << ' '
+               << path << ' ' << body.size() << '\n';
+        std::string headerLine = header.str();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_file.is_open() || m_segmentWritten >= m_segmentBytes) {
+            if (!OpenSegment()) {
+                m_writeFailures.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        m_file.write(headerLine.data(), static_cast<std::streamsize>(headerLine.size()));
+        m_file.write(body.data(), static_cast<std::streamsize>(body.size()));
+        m_file.put('\n');
+        m_file.flush();  // 进程异常退出时保留已抓取的记录
+        if (!m_file) {
+            m_writeFailures.fetch_add(1, std::memory_order_relaxed);
+            std::cerr << "ApiCaptureWriter: 写入失败 - " << m_currentPath << std::endl;
+            m_file.close();
+            return;
+        }
+
+        uint64_t written = headerLine.size() + body.size() + 1;
+        m_segmentWritten += written;
+        m_bytes.fetch_add(written, std::memory_order_relaxed);
+        m_records.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 获取统计快照
+     */
+    ApiCaptureStats GetStats() const {
+        ApiCaptureStats stats;
+        stats.active = true;
+        stats.records = m_records.load(std::memory_order_relaxed);
+        stats.bytes = m_bytes.load(std::memory_order_relaxed);
+        stats.segments = m_segments.load(std::memory_order_relaxed);
+        stats.writeFailures = m_writeFailures.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    /**
+     * @brief 关闭当前分段并打开下一个（调用方持有锁）
+     */
+    bool OpenSegment() {
+        if (m_file.is_open()) {
+            m_file.close();
+        }
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), "-%06llu.cap",
+                      static_cast<unsigned long long>(m_segments.load(std::memory_order_relaxed) + 1));
+        m_currentPath = m_pathPrefix + suffix;
+        m_file.clear();
+        m_file.open(m_currentPath, std::ios::binary | std::ios::trunc);
+        if (!m_file) {
+            std::cerr << "ApiCaptureWriter: 无法创建抓取文件 " << m_currentPath << std::endl;
+            return false;
+        }
+        m_file << api_capture_format::MAGIC << '\n';
+        m_segmentWritten = 0;
+        m_segments.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    std::string m_pathPrefix;
+    size_t m_segmentBytes;
+
+    std::mutex m_mutex;
+    std::ofstream m_file;                   // 当前分段
+    std::string m_currentPath;
+    uint64_t m_segmentWritten = 0;          // 当前分段已写入的字节数
+
+    std::atomic<uint64_t> m_records{0};
+    std::atomic<uint64_t> m_bytes{0};
+    std::atomic<uint64_t> m_segments{0};
+    std::atomic<uint64_t> m_writeFailures{0};
+};
+
+/**
+ * @brief ApiCaptureReader - 读取抓取分段文件（回放工具使用）
+ */
+class ApiCaptureReader {
+public:
+    /**
+     * @brief 读取一个分段文件的全部记录，追加到records
+     *
+     * 文件末尾不完整的记录（抓取进程被中断）被忽略。
+     *
+     * @return false 如果文件无法打开或格式错误
+     */
+    static bool Load(const std::string& filePath, std::vector<CapturedResponse>& records) {
+        std::ifstream file(filePath, std::ios::binary);
+        if (!file) {
+            std::cerr << "ApiCaptureReader: 无法打开 " << filePath << std::endl;
+            return false;
+        }
+
+        std::string line;
+        if (!std::getline(file, line) || line != api_capture_format::MAGIC) {
+            std::cerr << "ApiCaptureReader: 不是抓取文件 " << filePath << std::endl;
+            return false;
+        }
+
+        while (std::getline(file, line)) {
+            if (line.empty()) {
+                continue;
+            }
+            CapturedResponse record;
+            size_t length = 0;
+            std::istringstream header(line);
+            if (!(header >> record.capturedAtUs >> record.durationUs >> record.status >> record.path >> length)) {
+                std::cerr << "ApiCaptureReader: 记录头格式错误 " << filePath << std::endl;
+                return false;
+            }
+            record.body.resize(length);
+            if (!file.read(&record.body[0], static_cast<std::streamsize>(length))) {
+                std::cerr << "ApiCaptureReader: 忽略不完整的记录 " << filePath << std::endl;
+                break;
+            }
+            records.push_back(std::move(record));
+        }
+        return true;
+    }
+};
+
+} // namespace zygl::infrastructure
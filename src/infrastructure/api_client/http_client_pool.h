@@ -0,0 +1,234 @@
+#pragma once
+
+#include "../metrics/latency_histogram.h"
+#include "../../../third_party/httplib.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace zygl::infrastructure {
+
+/**
+ * @brief 连接池统计快照
+ */
+struct HttpClientPoolStats {
+    uint64_t checkouts = 0;             // 成功借出次数
+    uint64_t reusedConnections = 0;     // 借出时连接仍然打开（复用keep-alive连接）的次数
+    uint64_t newConnections = 0;        // 借出时没有打开的连接（本次调用需要建立连接）的次数
+    uint64_t waits = 0;                 // 所有客户端都在使用中、需要等待归还的次数
+    uint64_t exhausted = 0;             // 等待超时仍未借到客户端的次数
+    size_t capacity = 0;                // 客户端数上限
+    size_t created = 0;                 // 当前已创建的客户端数
+    size_t idle = 0;                    // 当前空闲的客户端数
+    LatencySummary checkoutWait;        // 借出等待时间分布
+};
+
+/**
+ * @brief HttpClientPool - 后端HTTP客户端池（keep-alive连接复用）
+ *
+ * httplib::Client内部串行化请求，并且超时设置是客户端级别的，
+ * 多个线程共用一个客户端时既无法并发，修改超时也会影响正在进行的请求。
+ * 连接池按需创建最多capacity个客户端，每次调用借出一个独占使用：
+ * - 借出时按本次调用的超时设置客户端（每次调用可以使用不同的超时）
+ * - 归还后放回空闲栈，后进先出，优先复用最近使用过、连接仍然打开的客户端
+ * - 客户端开启keep-alive，连续的调用复用同一条TCP连接；
+ *   后端关闭了空闲连接时httplib会在下次请求前自动重连
+ * - 所有客户端都在使用中时等待归还，超过本次调用的超时则借出失败
+ *
+ * 线程安全：
+ * - 所有方法都可以被任意线程并发调用；借出的客户端只由持有Lease的线程使用
+ */
+class HttpClientPool {
+public:
+    /**
+     * @brief 借出的客户端（析构时自动归还）
+     */
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept
+            : m_pool(other.m_pool), m_client(std::move(other.m_client)) {
+            other.m_pool = nullptr;
+        }
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                Return();
+                m_pool = other.m_pool;
+                m_client = std::move(other.m_client);
+                other.m_pool = nullptr;
+            }
+            return *this;
+        }
+        ~Lease() {
+            Return();
+        }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        explicit operator bool() const { return m_client != nullptr; }
+        httplib::Client* operator->() const { return m_client.get(); }
+        httplib::Client& operator*() const { return *m_client; }
+
+    private:
+        friend class HttpClientPool;
+
+        Lease(HttpClientPool* pool, std::unique_ptr<httplib::Client> client)
+            : m_pool(pool), m_client(std::move(client)) {
+        }
+
+        void Return() {
+            if (m_pool != nullptr && m_client != nullptr) {
+                m_pool->Release(std::move(m_client));
+            }
+            m_pool = nullptr;
+        }
+
+        HttpClientPool* m_pool = nullptr;
+        std::unique_ptr<httplib::Client> m_client;
+    };
+
+    /**
+     * @brief 构造函数
+     *
+     * @param baseUrl 后端基础URL（如 "http://192.168.1.100:8080"）
+     * @param capacity 客户端数上限（即到后端的最大并发连接数）
+     */
+    HttpClientPool(std::string baseUrl, size_t capacity)
+        : m_baseUrl(std::move(baseUrl)),
+          m_capacity(std::max<size_t>(capacity, 1)) {
+    }
+
+    // 禁止拷贝
+    HttpClientPool(const HttpClientPool&) = delete;
+    HttpClientPool& operator=(const HttpClientPool&) = delete;
+
+    /**
+     * @brief 设置客户端数上限（超出上限的空闲客户端立即销毁，借出中的在归还时销毁）
+     */
+    void SetCapacity(size_t capacity) {
+        std::vector<std::unique_ptr<httplib::Client>> discarded;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_capacity = std::max<size_t>(capacity, 1);
+            while (m_created > m_capacity && !m_idle.empty()) {
+                discarded.push_back(std::move(m_idle.back()));
+                m_idle.pop_back();
+                m_created--;
+            }
+        }
+        m_cv.notify_all();
+    }
+
+    /**
+     * @brief 借出一个客户端
+     *
+     * @param timeout 本次调用的超时（同时作为连接/读/写超时，以及等待归还的上限）
+     * @return 借出的客户端，等待超时时为空
+     */
+    Lease Acquire(std::chrono::milliseconds timeout) {
+        auto startedAt = std::chrono::steady_clock::now();
+        std::unique_ptr<httplib::Client> client;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_idle.empty() && m_created >= m_capacity) {
+                m_waits.fetch_add(1, std::memory_order_relaxed);
+                bool available = m_cv.wait_for(lock, timeout, [this]() {
+                    return !m_idle.empty() || m_created < m_capacity;
+                });
+                if (!available) {
+                    m_exhausted.fetch_add(1, std::memory_order_relaxed);
+                    return Lease();
+                }
+            }
+            if (!m_idle.empty()) {
+                client = std::move(m_idle.back());
+                m_idle.pop_back();
+            } else {
+                m_created++;
+            }
+        }
+        m_checkoutWait.Record(std::chrono::steady_clock::now() - startedAt);
+
+        if (!client) {
+            client = std::make_unique<httplib::Client>(m_baseUrl);
+            client->set_keep_alive(true);
+        }
+        if (client->is_socket_open() > 0) {
+            m_reusedConnections.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            m_newConnections.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // 客户端由本次调用独占，修改超时不影响其他调用；
+        // 调用方可能修改过的逐次设置（自动解压）恢复默认
+        client->set_connection_timeout(timeout);
+        client->set_read_timeout(timeout);
+        client->set_write_timeout(timeout);
+        client->set_decompress(true);
+
+        m_checkouts.fetch_add(1, std::memory_order_relaxed);
+        return Lease(this, std::move(client));
+    }
+
+    /**
+     * @brief 获取统计快照
+     */
+    HttpClientPoolStats GetStats() const {
+        HttpClientPoolStats stats;
+        stats.checkouts = m_checkouts.load(std::memory_order_relaxed);
+        stats.reusedConnections = m_reusedConnections.load(std::memory_order_relaxed);
+        stats.newConnections = m_newConnections.load(std::memory_order_relaxed);
+        stats.waits = m_waits.load(std::memory_order_relaxed);
+        stats.exhausted = m_exhausted.load(std::memory_order_relaxed);
+        stats.checkoutWait = m_checkoutWait.GetSummary();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            stats.capacity = m_capacity;
+            stats.created = m_created;
+            stats.idle = m_idle.size();
+        }
+        return stats;
+    }
+
+private:
+    /**
+     * @brief 归还客户端（由Lease析构调用）
+     */
+    void Release(std::unique_ptr<httplib::Client> client) {
+        std::unique_ptr<httplib::Client> discarded;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_created > m_capacity) {
+                // 上限已调小：销毁多余的客户端（在锁外关闭连接）
+                m_created--;
+                discarded = std::move(client);
+            } else {
+                m_idle.push_back(std::move(client));
+            }
+        }
+        m_cv.notify_one();
+    }
+
+    std::string m_baseUrl;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    size_t m_capacity;                                          // 客户端数上限
+    size_t m_created = 0;                                       // 已创建的客户端数（空闲 + 借出）
+    std::vector<std::unique_ptr<httplib::Client>> m_idle;       // 空闲客户端（后进先出）
+
+    std::atomic<uint64_t> m_checkouts{0};
+    std::atomic<uint64_t> m_reusedConnections{0};
+    std::atomic<uint64_t> m_newConnections{0};
+    std::atomic<uint64_t> m_waits{0};
+    std::atomic<uint64_t> m_exhausted{0};
+    LatencyHistogram m_checkoutWait;                            // 借出等待时间
+};
+
+} // namespace zygl::infrastructure
@@ -6,10 +6,16 @@
 #include <memory>
 #include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 
 // HTTP库和JSON库
 #include "../../../third_party/httplib.h"
 #include "../../../third_party/json.hpp"
+#include "http_client_pool.h"
+#include "response_body_decoder.h"
+#include "api_capture.h"
 
 namespace zygl::infrastructure {
 
@@ -107,6 +113,16 @@ struct DeployResponse {
     std::vector<StackResult> failureStackInfos;
 };
 
+/**
+ * @brief 拉取到的原始响应（采集用）
+ */
+struct FetchedBody {
+    bool notModified = false;   // 条件请求命中（HTTP 304），body为空
+    std::string body;           // 响应体（已解压）
+    std::string etag;           // 响应的ETag头（后端不支持时为空）
+    size_t wireBytes = 0;       // 实际传输的响应体字节数（压缩传输时为压缩后的大小）
+};
+
 /**
  * @brief QywApiClient - 后端API客户端
  * 
@@ -115,7 +131,10 @@ struct DeployResponse {
  * 2. 解析JSON响应为C++结构
  * 3. 错误处理和重试
  * 
- * 使用cpp-httplib库进行HTTP通信。
+ * 使用cpp-httplib库进行HTTP通信。每次调用从HttpClientPool借出一个独占的keep-alive客户端，
+ * 采集（boardinfo/stackinfo并发）和部署/卸载可以同时进行，互不串行化，也不必每次重新建立连接。
+ * 每次调用在借出时应用自己的超时（采集/查询使用SetTimeout()，部署/卸载使用SetDeployTimeout()），
+ * 修改超时只影响之后的调用，不会替换正在使用中的客户端。
  * 
  * 注意：本头文件提供接口定义，实际实现需要：
  * 1. 引入cpp-httplib库
@@ -124,14 +143,20 @@ struct DeployResponse {
  */
 class QywApiClient {
 public:
+    static constexpr size_t DEFAULT_MAX_CONNECTIONS = 4;   // 默认连接池大小
+
     /**
      * @brief 构造函数
      * @param baseUrl API基础URL（如 "http://192.168.1.100:8080"）
      * @param timeout 超时时间（秒），默认10秒
+     * @param maxConnections 到后端的最大并发连接数（连接池大小）
      */
-    explicit QywApiClient(const std::string& baseUrl, int timeout = 10)
-        : m_baseUrl(baseUrl), m_timeout(timeout) {
-        InitializeClient();
+    explicit QywApiClient(const std::string& baseUrl, int timeout = 10,
+                          size_t maxConnections = DEFAULT_MAX_CONNECTIONS)
+        : m_baseUrl(baseUrl),
+          m_timeout(timeout),
+          m_deployTimeout(timeout),
+          m_pool(baseUrl, maxConnections) {
     }
 
     /**
@@ -142,27 +167,11 @@ class QywApiClient {
      * @return 板卡信息列表，如果失败返回空optional
      */
     std::optional<std::vector<BoardInfoData>> GetBoardInfo() const {
-        try {
-            // 发送GET请求（复用HTTP客户端）
-            auto res = m_client->Get("/api/v1/external/qyw/boardinfo");
-            
-            if (!res) {
-                std::cerr << "GetBoardInfo: 请求失败 - 无响应" << std::endl;
-                return std::nullopt;
-            }
-            
-            if (res->status != 200) {
-                std::cerr << "GetBoardInfo: HTTP错误 " << res->status << std::endl;
-                return std::nullopt;
-            }
-            
-            // 解析JSON响应
-            return ParseBoardInfoResponse(res->body);
-            
-        } catch (const std::exception& e) {
-            std::cerr << "GetBoardInfo: 异常 - " << e.what() << std::endl;
+        auto fetched = FetchBoardInfoBody();
+        if (!fetched.has_value()) {
             return std::nullopt;
         }
+        return ParseBoardInfoResponse(fetched->body);
     }
 
     /**
@@ -173,27 +182,46 @@ class QywApiClient {
      * @return 业务链路信息列表，如果失败返回空optional
      */
     std::optional<std::vector<StackInfoData>> GetStackInfo() const {
-        try {
-            // 发送GET请求（复用HTTP客户端）
-            auto res = m_client->Get("/api/v1/external/qyw/stackinfo");
-            
-            if (!res) {
-                std::cerr << "GetStackInfo: 请求失败 - 无响应" << std::endl;
-                return std::nullopt;
-            }
-            
-            if (res->status != 200) {
-                std::cerr << "GetStackInfo: HTTP错误 " << res->status << std::endl;
-                return std::nullopt;
-            }
-            
-            // 解析JSON响应
-            return ParseStackInfoResponse(res->body);
-            
-        } catch (const std::exception& e) {
-            std::cerr << "GetStackInfo: 异常 - " << e.what() << std::endl;
+        auto fetched = FetchStackInfoBody();
+        if (!fetched.has_value()) {
             return std::nullopt;
         }
+        return ParseStackInfoResponse(fetched->body);
+    }
+
+    /**
+     * @brief 拉取板卡信息的原始响应体（不解析）
+     *
+     * 采集服务用拉取/解析分开的接口分别统计两段耗时。
+     * 每次调用从连接池借出独立的客户端，两个接口可以被不同线程同时拉取，
+     * 也不会被Deploy/Undeploy阻塞。
+     *
+     * @param ifNoneMatch 上次已处理响应的ETag（非空时发送If-None-Match，后端可回复304）
+     * @return 响应（含ETag），如果失败返回空optional
+     */
+    std::optional<FetchedBody> FetchBoardInfoBody(const std::string& ifNoneMatch = "") const {
+        return FetchBody("/api/v1/external/qyw/boardinfo", "GetBoardInfo", ifNoneMatch);
+    }
+
+    /**
+     * @brief 拉取业务链路信息的原始响应体（不解析）
+     */
+    std::optional<FetchedBody> FetchStackInfoBody(const std::string& ifNoneMatch = "") const {
+        return FetchBody("/api/v1/external/qyw/stackinfo", "GetStackInfo", ifNoneMatch);
+    }
+
+    /**
+     * @brief 解析板卡信息响应体
+     */
+    std::optional<std::vector<BoardInfoData>> ParseBoardInfo(const std::string& body) const {
+        return ParseBoardInfoResponse(body);
+    }
+
+    /**
+     * @brief 解析业务链路信息响应体
+     */
+    std::optional<std::vector<StackInfoData>> ParseStackInfo(const std::string& body) const {
+        return ParseStackInfoResponse(body);
     }
 
     /**
@@ -205,34 +233,7 @@ class QywApiClient {
      * @return 部署结果（成功和失败的业务链路），如果失败返回空optional
      */
     std::optional<DeployResponse> Deploy(const std::vector<std::string>& stackLabels) const {
-        try {
-            // 构建JSON请求体
-            nlohmann::json body;
-            body["stackLabels"] = stackLabels;
-            std::string jsonStr = body.dump();
-            
-            // 发送POST请求（复用HTTP客户端）
-            auto res = m_client->Post("/api/v1/external/qyw/deploy",
-                                     jsonStr,
-                                     "application/json");
-            
-            if (!res) {
-                std::cerr << "Deploy: 请求失败 - 无响应" << std::endl;
-                return std::nullopt;
-            }
-            
-            if (res->status != 200) {
-                std::cerr << "Deploy: HTTP错误 " << res->status << std::endl;
-                return std::nullopt;
-            }
-            
-            // 解析JSON响应
-            return ParseDeployResponse(res->body);
-            
-        } catch (const std::exception& e) {
-            std::cerr << "Deploy: 异常 - " << e.what() << std::endl;
-            return std::nullopt;
-        }
+        return PostStackLabels("/api/v1/external/qyw/deploy", "Deploy", stackLabels);
     }
 
     /**
@@ -244,34 +245,7 @@ class QywApiClient {
      * @return 停用结果（成功和失败的业务链路），如果失败返回空optional
      */
     std::optional<DeployResponse> Undeploy(const std::vector<std::string>& stackLabels) const {
-        try {
-            // 构建JSON请求体
-            nlohmann::json body;
-            body["stackLabels"] = stackLabels;
-            std::string jsonStr = body.dump();
-            
-            // 发送POST请求（复用HTTP客户端）
-            auto res = m_client->Post("/api/v1/external/qyw/undeploy",
-                                     jsonStr,
-                                     "application/json");
-            
-            if (!res) {
-                std::cerr << "Undeploy: 请求失败 - 无响应" << std::endl;
-                return std::nullopt;
-            }
-            
-            if (res->status != 200) {
-                std::cerr << "Undeploy: HTTP错误 " << res->status << std::endl;
-                return std::nullopt;
-            }
-            
-            // 解析JSON响应
-            return ParseDeployResponse(res->body);
-            
-        } catch (const std::exception& e) {
-            std::cerr << "Undeploy: 异常 - " << e.what() << std::endl;
-            return std::nullopt;
-        }
+        return PostStackLabels("/api/v1/external/qyw/undeploy", "Undeploy", stackLabels);
     }
 
     /**
@@ -280,7 +254,12 @@ class QywApiClient {
      */
     bool TestConnection() const {
         try {
-            auto res = m_client->Get("/api/v1/external/qyw/boardinfo");
+            auto client = m_pool.Acquire(CallTimeout(m_timeout));
+            if (!client) {
+                std::cerr << "TestConnection: 连接池已满" << std::endl;
+                return false;
+            }
+            auto res = client->Get("/api/v1/external/qyw/boardinfo");
             
             // 只要能连接上并收到响应（200或其他状态码），都认为连接成功
             return res && (res->status == 200 || res->status == 401 || res->status >= 100);
@@ -291,13 +270,67 @@ class QywApiClient {
     }
 
     /**
-     * @brief 设置超时时间
+     * @brief 设置超时时间（采集/查询，之后借出的客户端生效，可以在任意线程调用）
      * @param timeout 超时时间（秒）
      */
     void SetTimeout(int timeout) {
-        m_timeout = timeout;
-        // 重新初始化客户端以应用新超时
-        InitializeClient();
+        m_timeout.store(timeout, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 设置部署/卸载的超时时间（秒，默认与构造时的超时相同）
+     */
+    void SetDeployTimeout(int timeout) {
+        m_deployTimeout.store(timeout, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 设置到后端的最大并发连接数（连接池大小）
+     */
+    void SetMaxConnections(size_t maxConnections) {
+        m_pool.SetCapacity(maxConnections);
+    }
+
+    /**
+     * @brief 获取连接池统计（借出次数、连接复用次数、等待次数等）
+     */
+    HttpClientPoolStats GetPoolStats() const {
+        return m_pool.GetStats();
+    }
+
+    /**
+     * @brief 开始抓取：之后每个成功拉取的boardinfo/stackinfo响应体（解压后）连同时间戳写入分段文件
+     *
+     * 用于离线复现采集性能问题：抓取文件可由tools/api_replay_server回放。
+     * 写入在拉取线程中同步进行，只应在排查问题时开启。再次调用时换用新的文件前缀。
+     *
+     * @param pathPrefix 分段文件路径前缀（如 "capture/qyw"，目录需要存在）
+     * @param segmentBytes 分段大小（字节），0时使用默认值
+     * @return false 如果无法创建第一个分段文件
+     */
+    bool StartCapture(const std::string& pathPrefix,
+                      size_t segmentBytes = ApiCaptureWriter::DEFAULT_SEGMENT_BYTES) {
+        auto writer = std::make_shared<ApiCaptureWriter>(pathPrefix, segmentBytes);
+        if (!writer->Open()) {
+            return false;
+        }
+        std::atomic_store(&m_capture, writer);
+        return true;
+    }
+
+    /**
+     * @brief 停止抓取（正在写入的记录写完后关闭文件）
+     */
+    void StopCapture() {
+        std::atomic_store(&m_capture, std::shared_ptr<ApiCaptureWriter>());
+    }
+
+    /**
+     * @brief 获取抓取统计（未抓取时active为false）
+     */
+    ApiCaptureStats GetCaptureStats() const {
+        auto writer = std::atomic_load(&m_capture);
+        return writer ? writer->GetStats() : ApiCaptureStats();
     }
 
     /**
@@ -309,16 +342,168 @@ class QywApiClient {
 
 private:
     std::string m_baseUrl;      // API基础URL
-    int m_timeout;              // 超时时间（秒）
-    mutable std::unique_ptr<httplib::Client> m_client;  // 复用的HTTP客户端
-    
+    std::atomic<int> m_timeout;         // 采集/查询超时时间（秒）
+    std::atomic<int> m_deployTimeout;   // 部署/卸载超时时间（秒）
+    mutable HttpClientPool m_pool;      // keep-alive客户端池（每次调用借出一个）
+    std::shared_ptr<ApiCaptureWriter> m_capture;    // 响应抓取（为空表示未抓取，用atomic_load/atomic_store访问）
+
+    static std::chrono::milliseconds CallTimeout(const std::atomic<int>& seconds) {
+        return std::chrono::seconds(std::max(1, seconds.load(std::memory_order_relaxed)));
+    }
+
     /**
-     * @brief 初始化HTTP客户端
+     * @brief 发送GET请求并返回响应体
+     *
+     * 启用zlib时请求gzip压缩传输。响应体逐块到达时由ResponseBodyDecoder解压，
+     * 直接追加到交给解析器的响应体中（不缓存完整的压缩数据），同时统计传输字节数。
+     *
+     * @param path 接口路径
+     * @param operation 日志中的操作名称
+     * @param ifNoneMatch 条件请求的ETag（空表示不发送）
      */
-    void InitializeClient() const {
-        m_client = std::make_unique<httplib::Client>(m_baseUrl);
-        m_client->set_connection_timeout(0, m_timeout * 1000000);  // 微秒
-        m_client->set_read_timeout(m_timeout, 0);  // 秒
+    std::optional<FetchedBody> FetchBody(const char* path, const char* operation,
+                                         const std::string& ifNoneMatch) const {
+        try {
+            auto client = m_pool.Acquire(CallTimeout(m_timeout));
+            if (!client) {
+                std::cerr << operation << ": 连接池已满，等待超时" << std::endl;
+                return std::nullopt;
+            }
+
+            httplib::Headers headers;
+            if (!ifNoneMatch.empty()) {
+                headers.emplace("If-None-Match", ifNoneMatch);
+            }
+            if (ResponseBodyDecoder::SupportsCompression()) {
+                headers.emplace("Accept-Encoding", "gzip");
+            }
+
+            // 自行解码以统计压缩前后的字节数（本次借出有效，归还后恢复默认）
+            client->set_decompress(false);
+
+            auto capture = std::atomic_load(&m_capture);
+            auto requestedAt = std::chrono::system_clock::now();
+            auto startedAt = std::chrono::steady_clock::now();
+
+            FetchedBody fetched;
+            ResponseBodyDecoder decoder;
+            bool receiving = false;         // 只接收200响应的响应体
+            bool decodeFailed = false;
+            auto res = client->Get(path, headers,
+                [&](const httplib::Response& response) {
+                    if (response.status != 200) {
+                        return true;
+                    }
+                    if (!decoder.Begin(response.get_header_value("Content-Encoding"))) {
+                        std::cerr << operation << ": 不支持的Content-Encoding "
+                                  << response.get_header_value("Content-Encoding") << std::endl;
+                        return false;
+                    }
+                    receiving = true;
+                    return true;
+                },
+                [&](const char* data, size_t length) {
+                    if (!receiving) {
+                        return true;
+                    }
+                    fetched.wireBytes += length;
+                    if (!decoder.Decode(data, length, fetched.body)) {
+                        decodeFailed = true;
+                        return false;
+                    }
+                    return true;
+                });
+            
+            if (decodeFailed) {
+                std::cerr << operation << ": 响应体解压失败" << std::endl;
+                return std::nullopt;
+            }
+
+            if (!res) {
+                std::cerr << operation << ": 请求失败 - 无响应" << std::endl;
+                return std::nullopt;
+            }
+            
+            if (res->status == 304 && !ifNoneMatch.empty()) {
+                fetched.notModified = true;
+                fetched.etag = ifNoneMatch;
+                return fetched;
+            }
+            
+            if (res->status != 200) {
+                std::cerr << operation << ": HTTP错误 " << res->status << std::endl;
+                return std::nullopt;
+            }
+
+            if (!decoder.IsComplete()) {
+                std::cerr << operation << ": 压缩响应体不完整" << std::endl;
+                return std::nullopt;
+            }
+            
+            fetched.etag = res->get_header_value("ETag");
+            if (capture) {
+                CaptureResponse(*capture, path, requestedAt, startedAt, fetched.body);
+            }
+            return fetched;
+            
+        } catch (const std::exception& e) {
+            std::cerr << operation << ": 异常 - " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+
+    /**
+     * @brief 将一个拉取到的响应体写入抓取文件
+     */
+    static void CaptureResponse(ApiCaptureWriter& capture, const char* path,
+                                std::chrono::system_clock::time_point requestedAt,
+                                std::chrono::steady_clock::time_point startedAt,
+                                const std::string& body) {
+        capture.Write(
+            std::chrono::duration_cast<std::chrono::microseconds>(requestedAt.time_since_epoch()).count(),
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startedAt).count(),
+            200, path, body);
+    }
+
+    /**
+     * @brief 发送部署/卸载请求（POST {"stackLabels": [...]}）并解析响应
+     *
+     * @param path 接口路径
+     * @param operation 日志中的操作名称
+     * @param stackLabels 业务链路标签UUID列表
+     */
+    std::optional<DeployResponse> PostStackLabels(const char* path, const char* operation,
+                                                  const std::vector<std::string>& stackLabels) const {
+        try {
+            // 构建JSON请求体
+            nlohmann::json body;
+            body["stackLabels"] = stackLabels;
+            std::string jsonStr = body.dump();
+            
+            auto client = m_pool.Acquire(CallTimeout(m_deployTimeout));
+            if (!client) {
+                std::cerr << operation << ": 连接池已满，等待超时" << std::endl;
+                return std::nullopt;
+            }
+            auto res = client->Post(path, jsonStr, "application/json");
+            
+            if (!res) {
+                std::cerr << operation << ": 请求失败 - 无响应" << std::endl;
+                return std::nullopt;
+            }
+            
+            if (res->status != 200) {
+                std::cerr << operation << ": HTTP错误 " << res->status << std::endl;
+                return std::nullopt;
+            }
+            
+            // 解析JSON响应
+            return ParseDeployResponse(res->body);
+            
+        } catch (const std::exception& e) {
+            std::cerr << operation << ": 异常 - " << e.what() << std::endl;
+            return std::nullopt;
+        }
     }
 
     /**
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+#include <zlib.h>
+#endif
+
+namespace zygl::infrastructure {
+
+/**
+ * @brief ResponseBodyDecoder - 响应体流式解码（按Content-Encoding）
+ *
+ * 在HTTP客户端逐块收到响应体时调用Decode()，解码结果直接追加到输出缓冲
+ * （即随后交给JSON解析器的响应体），不保留压缩数据的完整副本。
+ * - 未压缩（无Content-Encoding或identity）：原样追加
+ * - gzip/deflate（zlib格式）：启用CPPHTTPLIB_ZLIB_SUPPORT（ENABLE_ZLIB / make ZLIB=1）时逐块解压，
+ *   未启用时Begin()返回false（此时客户端也不会请求压缩）
+ *
+ * 一个实例解码一个响应体，不可复用。
+ */
+class ResponseBodyDecoder {
+public:
+    ResponseBodyDecoder() = default;
+
+    ~ResponseBodyDecoder() {
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+        if (m_mode == Mode::Inflate) {
+            inflateEnd(&m_stream);
+        }
+#endif
+    }
+
+    // 禁止拷贝
+    ResponseBodyDecoder(const ResponseBodyDecoder&) = delete;
+    ResponseBodyDecoder& operator=(const ResponseBodyDecoder&) = delete;
+
+    /**
+     * @brief 是否支持压缩传输（编译时启用了zlib）
+     */
+    static constexpr bool SupportsCompression() {
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 按响应的Content-Encoding开始解码
+     *
+     * @return false 如果编码不受支持
+     */
+    bool Begin(const std::string& contentEncoding) {
+        if (contentEncoding.empty() || contentEncoding == "identity") {
+            m_mode = Mode::Identity;
+            return true;
+        }
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+        if (contentEncoding == "gzip" || contentEncoding == "deflate") {
+            std::memset(&m_stream, 0, sizeof(m_stream));
+            // 15 + 32：窗口15位，自动识别gzip和zlib头
+            if (inflateInit2(&m_stream, 15 + 32) != Z_OK) {
+                return false;
+            }
+            m_mode = Mode::Inflate;
+            return true;
+        }
+#endif
+        return false;
+    }
+
+    /**
+     * @brief 解码一块收到的数据，结果追加到out
+     *
+     * @return false 如果数据损坏
+     */
+    bool Decode(const char* data, size_t length, std::string& out) {
+        if (m_mode == Mode::Identity) {
+            out.append(data, length);
+            return true;
+        }
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+        if (m_mode == Mode::Inflate) {
+            return Inflate(data, length, out);
+        }
+#endif
+        return false;
+    }
+
+    /**
+     * @brief 响应体是否已完整解码（压缩流必须到达结尾）
+     */
+    bool IsComplete() const {
+        return m_mode == Mode::Identity || m_finished;
+    }
+
+private:
+    enum class Mode {
+        None,
+        Identity,
+        Inflate
+    };
+
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+    static constexpr size_t MIN_OUTPUT_CHUNK = 16 * 1024;
+
+    /**
+     * @brief 解压到out的尾部（直接写入输出缓冲，不经过中间缓冲）
+     *
+     * 输出空间用满时继续循环（即使输入已全部读入，zlib内部可能还有未输出的数据，
+     * 流结尾也可能尚未处理）；只有输出空间有剩余时才说明需要等待下一块输入。
+     */
+    bool Inflate(const char* data, size_t length, std::string& out) {
+        m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        m_stream.avail_in = static_cast<uInt>(length);
+
+        while (!m_finished) {
+            size_t chunk = std::max(MIN_OUTPUT_CHUNK, length * 4);
+            size_t used = out.size();
+            out.resize(used + chunk);
+            m_stream.next_out = reinterpret_cast<Bytef*>(&out[used]);
+            m_stream.avail_out = static_cast<uInt>(chunk);
+
+            int ret = inflate(&m_stream, Z_NO_FLUSH);
+            bool outputFull = m_stream.avail_out == 0;
+            out.resize(used + chunk - m_stream.avail_out);
+
+            if (ret == Z_STREAM_END) {
+                m_finished = true;
+            } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+                return false;
+            } else if (!outputFull) {
+                break;  // 输入已处理完，等待下一块
+            }
+        }
+        return true;
+    }
+
+    z_stream m_stream;
+#endif
+
+    Mode m_mode = Mode::None;
+    bool m_finished = false;        // 压缩流已到达结尾
+};
+
+} // namespace zygl::infrastructure
@@ -0,0 +1,398 @@
+#pragma once
+
+#include "../../domain/stack.h"
+#include "../../domain/service.h"
+#include "../../domain/task.h"
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../../../third_party/json.hpp"
+
+namespace zygl::infrastructure {
+
+/**
+ * @brief StackInfoSaxParser - stackinfo响应的流式解析器
+ *
+ * stackinfo是采集的最大响应（数MB）。DOM方式需要三次完整的物化：
+ * nlohmann::json DOM → StackInfoData（大量std::string）→ domain::Stack。
+ * 本解析器基于nlohmann::json::sax_parse单次扫描响应体，直接构建domain::Stack：
+ * - 不构建DOM，不产生中间的StackInfoData
+ * - 定长字段（位置信息、资源使用、标签）直接写入领域值对象
+ * - 键名只在当前层级相关时才比较；未知的键及其嵌套内容整体跳过
+ *
+ * 字段的默认值与类型处理与QywApiClient::ParseStackInfoResponse一致（缺失字段取默认值），
+ * 区别是类型不符的字段被忽略而不是使整个响应解析失败。
+ *
+ * 线程安全：
+ * - Parse()是静态方法，可以被任意线程并发调用
+ */
+class StackInfoSaxParser {
+public:
+    /**
+     * @brief 解析stackinfo响应体
+     *
+     * @param body 响应体（{"data": [stack, ...], ...}）
+     * @return 业务链路列表，JSON错误或缺少data数组时返回空optional
+     */
+    static std::optional<std::vector<domain::Stack>> Parse(const std::string& body) {
+        Handler handler;
+        bool ok = nlohmann::json::sax_parse(body, &handler);
+        if (!ok) {
+            std::cerr << "StackInfoSaxParser: JSON解析错误 - " << handler.GetError() << std::endl;
+            return std::nullopt;
+        }
+        if (!handler.HasData()) {
+            std::cerr << "StackInfoSaxParser: 响应格式错误" << std::endl;
+            return std::nullopt;
+        }
+        return handler.TakeStacks();
+    }
+
+private:
+    /**
+     * @brief SAX事件处理器：按层级维护解析状态，对象结束时提交到上一层
+     */
+    class Handler : public nlohmann::json_sax<nlohmann::json> {
+    public:
+        Handler() {
+            m_levels.reserve(16);
+        }
+
+        bool HasData() const { return m_hasData; }
+        const std::string& GetError() const { return m_error; }
+        std::vector<domain::Stack> TakeStacks() { return std::move(m_stacks); }
+
+        // ==================== 值事件 ====================
+
+        bool null() override {
+            return true;
+        }
+
+        bool boolean(bool) override {
+            return true;
+        }
+
+        bool number_integer(number_integer_t value) override {
+            return OnNumber(static_cast<double>(value), static_cast<int64_t>(value));
+        }
+
+        bool number_unsigned(number_unsigned_t value) override {
+            return OnNumber(static_cast<double>(value), static_cast<int64_t>(value));
+        }
+
+        bool number_float(number_float_t value, const string_t&) override {
+            return OnNumber(static_cast<double>(value), static_cast<int64_t>(value));
+        }
+
+        bool string(string_t& value) override {
+            switch (Top()) {
+                case Level::Stack:
+                    if (m_field == Field::StackName) m_stack.name.swap(value);
+                    else if (m_field == Field::StackUUID) m_stack.uuid.swap(value);
+                    break;
+                case Level::Label:
+                    if (m_field == Field::LabelName) m_label.SetLabelName(value.c_str());
+                    else if (m_field == Field::LabelUUID) m_label.SetLabelUUID(value.c_str());
+                    break;
+                case Level::Service:
+                    if (m_field == Field::ServiceName) m_service.name.swap(value);
+                    else if (m_field == Field::ServiceUUID) m_service.uuid.swap(value);
+                    break;
+                case Level::Task:
+                    switch (m_field) {
+                        case Field::TaskID: m_task.id.swap(value); break;
+                        case Field::TaskStatus: m_task.status.swap(value); break;
+                        case Field::ChassisName: m_task.location.SetChassisName(value.c_str()); break;
+                        case Field::BoardName: m_task.location.SetBoardName(value.c_str()); break;
+                        case Field::BoardAddress: m_task.boardAddress.swap(value); break;
+                        default: break;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            return true;
+        }
+
+        bool binary(binary_t&) override {
+            return true;
+        }
+
+        // ==================== 结构事件 ====================
+
+        bool start_object(std::size_t) override {
+            Level level = Level::Skip;
+            switch (Top()) {
+                case Level::None: level = Level::Root; break;
+                case Level::DataArray: level = Level::Stack; m_stack.Reset(); break;
+                case Level::LabelArray: level = Level::Label; m_label = domain::StackLabelInfo(); break;
+                case Level::ServiceArray: level = Level::Service; m_service.Reset(); break;
+                case Level::TaskArray: level = Level::Task; m_task.Reset(); break;
+                default: break;
+            }
+            m_levels.push_back(level);
+            m_field = Field::Other;
+            return true;
+        }
+
+        bool end_object() override {
+            Level level = Top();
+            m_levels.pop_back();
+            switch (level) {
+                case Level::Stack: CommitStack(); break;
+                case Level::Label: m_stack.labels.push_back(m_label); break;
+                case Level::Service: CommitService(); break;
+                case Level::Task: CommitTask(); break;
+                default: break;
+            }
+            m_field = Field::Other;
+            return true;
+        }
+
+        bool start_array(std::size_t) override {
+            Level level = Level::Skip;
+            switch (Top()) {
+                case Level::Root:
+                    if (m_field == Field::Data) {
+                        level = Level::DataArray;
+                        m_hasData = true;
+                    }
+                    break;
+                case Level::Stack:
+                    if (m_field == Field::StackLabelInfos) level = Level::LabelArray;
+                    else if (m_field == Field::ServiceInfos) level = Level::ServiceArray;
+                    break;
+                case Level::Service:
+                    if (m_field == Field::TaskInfos) level = Level::TaskArray;
+                    break;
+                default:
+                    break;
+            }
+            m_levels.push_back(level);
+            return true;
+        }
+
+        bool end_array() override {
+            m_levels.pop_back();
+            m_field = Field::Other;
+            return true;
+        }
+
+        bool key(string_t& name) override {
+            m_field = ResolveField(Top(), name);
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string&,
+                         const nlohmann::detail::exception& ex) override {
+            m_error = ex.what();
+            return false;
+        }
+
+    private:
+        enum class Level : uint8_t {
+            None, Root, DataArray, Stack, LabelArray, Label,
+            ServiceArray, Service, TaskArray, Task, Skip
+        };
+
+        enum class Field : uint8_t {
+            Other, Data,
+            StackName, StackUUID, StackDeployStatus, StackRunningStatus, StackLabelInfos, ServiceInfos,
+            LabelName, LabelUUID,
+            ServiceName, ServiceUUID, ServiceStatus, ServiceType, TaskInfos,
+            TaskID, TaskStatus, CpuCores, CpuUsed, CpuUsage, MemorySize, MemoryUsed, MemoryUsage,
+            NetReceive, NetSent, GpuMemUsed, ChassisName, ChassisNumber, BoardName, BoardNumber, BoardAddress
+        };
+
+        struct FieldName {
+            const char* name;
+            Field field;
+        };
+
+        /**
+         * @brief 解析键名（只在当前层级的字段中查找，跳过的层级不比较）
+         */
+        static Field ResolveField(Level level, const std::string& name) {
+            static const FieldName ROOT_FIELDS[] = {{"data", Field::Data}};
+            static const FieldName STACK_FIELDS[] = {
+                {"stackName", Field::StackName}, {"stackUUID", Field::StackUUID},
+                {"stackDeployStatus", Field::StackDeployStatus}, {"stackRunningStatus", Field::StackRunningStatus},
+                {"stackLabelInfos", Field::StackLabelInfos}, {"serviceInfos", Field::ServiceInfos}};
+            static const FieldName LABEL_FIELDS[] = {
+                {"labelName", Field::LabelName}, {"labelUUID", Field::LabelUUID}};
+            static const FieldName SERVICE_FIELDS[] = {
+                {"serviceName", Field::ServiceName}, {"serviceUUID", Field::ServiceUUID},
+                {"serviceStatus", Field::ServiceStatus}, {"serviceType", Field::ServiceType},
+                {"taskInfos", Field::TaskInfos}};
+            static const FieldName TASK_FIELDS[] = {
+                {"taskID", Field::TaskID}, {"taskStatus", Field::TaskStatus},
+                {"cpuCores", Field::CpuCores}, {"cpuUsed", Field::CpuUsed}, {"cpuUsage", Field::CpuUsage},
+                {"memorySize", Field::MemorySize}, {"memoryUsed", Field::MemoryUsed},
+                {"memoryUsage", Field::MemoryUsage}, {"netReceive", Field::NetReceive},
+                {"netSent", Field::NetSent}, {"gpuMemUsed", Field::GpuMemUsed},
+                {"chassisName", Field::ChassisName}, {"chassisNumber", Field::ChassisNumber},
+                {"boardName", Field::BoardName}, {"boardNumber", Field::BoardNumber},
+                {"boardAddress", Field::BoardAddress}};
+
+            switch (level) {
+                case Level::Root: return Find(ROOT_FIELDS, name);
+                case Level::Stack: return Find(STACK_FIELDS, name);
+                case Level::Label: return Find(LABEL_FIELDS, name);
+                case Level::Service: return Find(SERVICE_FIELDS, name);
+                case Level::Task: return Find(TASK_FIELDS, name);
+                default: return Field::Other;
+            }
+        }
+
+        template<size_t N>
+        static Field Find(const FieldName (&fields)[N], const std::string& name) {
+            for (const auto& entry : fields) {
+                if (name == entry.name) {
+                    return entry.field;
+                }
+            }
+            return Field::Other;
+        }
+
+        Level Top() const {
+            return m_levels.empty() ? Level::None : m_levels.back();
+        }
+
+        bool OnNumber(double value, int64_t integer) {
+            auto asInt = static_cast<int32_t>(integer);
+            auto asFloat = static_cast<float>(value);
+            switch (Top()) {
+                case Level::Stack:
+                    if (m_field == Field::StackDeployStatus) m_stack.deployStatus = asInt;
+                    else if (m_field == Field::StackRunningStatus) m_stack.runningStatus = asInt;
+                    break;
+                case Level::Service:
+                    if (m_field == Field::ServiceStatus) m_service.status = asInt;
+                    else if (m_field == Field::ServiceType) m_service.type = asInt;
+                    break;
+                case Level::Task: {
+                    domain::ResourceUsage& r = m_task.resources;
+                    switch (m_field) {
+                        case Field::CpuCores: r.cpuCores = asFloat; break;
+                        case Field::CpuUsed: r.cpuUsed = asFloat; break;
+                        case Field::CpuUsage: r.cpuUsage = asFloat; break;
+                        case Field::MemorySize: r.memorySize = asFloat; break;
+                        case Field::MemoryUsed: r.memoryUsed = asFloat; break;
+                        case Field::MemoryUsage: r.memoryUsage = asFloat; break;
+                        case Field::NetReceive: r.netReceive = asFloat; break;
+                        case Field::NetSent: r.netSent = asFloat; break;
+                        case Field::GpuMemUsed: r.gpuMemUsed = asFloat; break;
+                        case Field::ChassisNumber: m_task.location.chassisNumber = asInt; break;
+                        case Field::BoardNumber: m_task.location.boardNumber = asInt; break;
+                        default: break;
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+            return true;
+        }
+
+        void CommitTask() {
+            domain::Task task(m_task.id);
+            task.SetTaskStatus(m_task.status);
+            task.SetBoardAddress(m_task.boardAddress);
+            task.UpdateResources(m_task.resources);
+            m_task.location.SetBoardAddress(m_task.boardAddress.c_str());
+            task.UpdateLocation(m_task.location);
+            m_service.tasks.push_back(std::move(task));
+        }
+
+        void CommitService() {
+            domain::Service service(m_service.uuid, m_service.name);
+            service.SetStatus(static_cast<domain::ServiceStatus>(m_service.status));
+            service.SetType(static_cast<domain::ServiceType>(m_service.type));
+            for (auto& task : m_service.tasks) {
+                service.AddOrUpdateTask(std::move(task));
+            }
+            m_stack.services.push_back(std::move(service));
+        }
+
+        void CommitStack() {
+            domain::Stack stack(m_stack.uuid, m_stack.name);
+            stack.SetDeployStatus(static_cast<domain::StackDeployStatus>(m_stack.deployStatus));
+            stack.SetRunningStatus(static_cast<domain::StackRunningStatus>(m_stack.runningStatus));
+            for (const auto& label : m_stack.labels) {
+                stack.AddLabel(label);
+            }
+            for (auto& service : m_stack.services) {
+                stack.AddOrUpdateService(std::move(service));
+            }
+            m_stacks.push_back(std::move(stack));
+        }
+
+        // 当前正在解析的对象（标识字段可能出现在子数组之后，因此子对象先暂存，对象结束时再构建）
+        struct TaskRecord {
+            std::string id;
+            std::string status;
+            std::string boardAddress;
+            domain::ResourceUsage resources;
+            domain::LocationInfo location;
+
+            void Reset() {
+                id.clear();
+                status.clear();
+                boardAddress.clear();
+                resources = domain::ResourceUsage();
+                location = domain::LocationInfo();
+            }
+        };
+
+        struct ServiceRecord {
+            std::string uuid;
+            std::string name;
+            int32_t status = 0;
+            int32_t type = 0;
+            std::vector<domain::Task> tasks;
+
+            void Reset() {
+                uuid.clear();
+                name.clear();
+                status = 0;
+                type = 0;
+                tasks.clear();
+            }
+        };
+
+        struct StackRecord {
+            std::string uuid;
+            std::string name;
+            int32_t deployStatus = 0;
+            int32_t runningStatus = 1;
+            std::vector<domain::StackLabelInfo> labels;
+            std::vector<domain::Service> services;
+
+            void Reset() {
+                uuid.clear();
+                name.clear();
+                deployStatus = 0;
+                runningStatus = 1;
+                labels.clear();
+                services.clear();
+            }
+        };
+
+        std::vector<Level> m_levels;        // 当前嵌套路径
+        Field m_field = Field::Other;       // 最近一个键
+        bool m_hasData = false;             // 是否遇到data数组
+        std::string m_error;
+
+        StackRecord m_stack;
+        ServiceRecord m_service;
+        TaskRecord m_task;
+        domain::StackLabelInfo m_label;
+
+        std::vector<domain::Stack> m_stacks;
+    };
+};
+
+} // namespace zygl::infrastructure
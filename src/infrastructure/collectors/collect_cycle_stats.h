@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace zygl::infrastructure {
+
+/**
+ * @brief 单个接口在一个采集周期中的结果
+ */
+enum class CollectOutcome {
+    NotCollected,   // 本周期未采集该接口（只刷新了另一个接口）
+    Applied,        // 已解析并写入仓储
+    Unchanged,      // 响应体哈希与上次相同，跳过解析和写入
+    NotModified,    // 后端回复304，跳过解析和写入
+    FetchFailed,    // 请求失败（无响应、HTTP错误、连接池已满、解压失败）
+    ParseFailed,    // 响应体解析失败
+    Exception       // 转换或写入时抛出异常
+};
+
+/**
+ * @brief 单个接口在一个采集周期中的明细（耗时单位：微秒）
+ *
+ * 阶段划分：fetch为HTTP请求到收完响应体；parse为JSON解析；convert为转换为领域对象并统计变化；
+ * commit为写入仓储（含双缓冲交换和索引更新）。stackinfo使用流式解析直接构建领域对象，
+ * 其convert只包含与上次写入的比较。未执行的阶段为0。
+ */
+struct CollectEndpointCycle {
+    CollectOutcome outcome = CollectOutcome::NotCollected;
+    uint64_t fetchUs = 0;
+    uint64_t parseUs = 0;
+    uint64_t convertUs = 0;
+    uint64_t commitUs = 0;
+    uint64_t compressedBytes = 0;   // 传输的响应体字节数（压缩传输时为压缩后的大小）
+    uint64_t rawBytes = 0;          // 解压后的响应体字节数
+    uint32_t changedEntities = 0;   // 状态发生变化的实体数（板卡 / 业务链路，见CollectCycleRecord）
+};
+
+/**
+ * @brief 一个采集周期的记录
+ *
+ * 数量为本周期结束时仓储中（最近一次写入的）数据：跳过写入的周期沿用上次的数量。
+ * 变化实体数：boardinfo为在线状态、运行状态或任务列表（任务ID/状态）发生变化的板卡数；
+ * stackinfo为新增、消失、或状态（部署/运行状态、组件状态、任务ID/状态/位置）发生变化的业务链路数。
+ * 资源使用率每个周期都会变化，不计入。
+ */
+struct CollectCycleRecord {
+    uint64_t sequence = 0;          // 周期序号（从1开始）
+    bool refresh = false;           // 是否为即时刷新（否则为正常采集）
+    int64_t startedAtMs = 0;        // 开始时间（Unix毫秒）
+    uint64_t totalUs = 0;           // 周期总耗时
+    CollectEndpointCycle boardInfo;
+    CollectEndpointCycle stackInfo;
+    uint32_t boardCount = 0;        // 后端上报的板卡数
+    uint32_t stackCount = 0;        // 业务链路数
+    uint32_t serviceCount = 0;      // 组件数
+    uint32_t taskCount = 0;         // 任务数
+
+    /**
+     * @brief 本周期是否有接口失败
+     */
+    bool Failed() const {
+        return IsFailure(boardInfo.outcome) || IsFailure(stackInfo.outcome);
+    }
+
+    static bool IsFailure(CollectOutcome outcome) {
+        return outcome == CollectOutcome::FetchFailed ||
+               outcome == CollectOutcome::ParseFailed ||
+               outcome == CollectOutcome::Exception;
+    }
+};
+
+/**
+ * @brief 一组样本的最小值/平均值/99分位（无样本时全为0）
+ */
+struct CollectValueSummary {
+    uint64_t samples = 0;
+    uint64_t min = 0;
+    uint64_t avg = 0;
+    uint64_t p99 = 0;
+};
+
+/**
+ * @brief 单个接口在最近N个周期中的汇总
+ *
+ * 每个阶段只统计执行了该阶段的周期（如parse不包含跳过解析的周期）。
+ */
+struct CollectEndpointSummary {
+    uint64_t applied = 0;
+    uint64_t unchanged = 0;         // 哈希相同跳过
+    uint64_t notModified = 0;       // 304跳过
+    uint64_t fetchFailures = 0;
+    uint64_t parseFailures = 0;
+    uint64_t exceptions = 0;
+    CollectValueSummary fetchUs;
+    CollectValueSummary parseUs;
+    CollectValueSummary convertUs;
+    CollectValueSummary commitUs;
+    CollectValueSummary compressedBytes;
+    CollectValueSummary rawBytes;
+    CollectValueSummary changedEntities;    // 只统计写入了仓储的周期
+};
+
+/**
+ * @brief 最近N个采集周期的汇总
+ */
+struct CollectCycleSummary {
+    uint64_t cycles = 0;            // 汇总的周期数
+    uint64_t refreshCycles = 0;     // 其中即时刷新的周期数
+    uint64_t failedCycles = 0;      // 其中有接口失败的周期数
+    CollectValueSummary totalUs;
+    CollectEndpointSummary boardInfo;
+    CollectEndpointSummary stackInfo;
+};
+
+/**
+ * @brief CollectCycleHistory - 最近N个采集周期的记录环
+ *
+ * 采集线程每个周期结束后Add()一条记录，超出容量时丢弃最旧的记录。
+ * 查询方（如应用层的监控服务）通过GetRecent()取明细，或GetSummary()取各阶段的最小值/平均值/99分位。
+ * 每个周期只写一次，查询不频繁，用互斥锁保护即可。
+ *
+ * 线程安全：
+ * - 所有方法都可以被任意线程并发调用
+ */
+class CollectCycleHistory {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 120;     // 默认保存最近120个周期
+
+    /**
+     * @brief 构造函数
+     *
+     * @param capacity 保存的周期数，0时使用默认值
+     */
+    explicit CollectCycleHistory(size_t capacity = DEFAULT_CAPACITY)
+        : m_capacity(capacity > 0 ? capacity : DEFAULT_CAPACITY) {
+    }
+
+    // 禁止拷贝
+    CollectCycleHistory(const CollectCycleHistory&) = delete;
+    CollectCycleHistory& operator=(const CollectCycleHistory&) = delete;
+
+    /**
+     * @brief 设置保存的周期数（超出部分丢弃最旧的记录）
+     */
+    void SetCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_capacity = capacity > 0 ? capacity : DEFAULT_CAPACITY;
+        while (m_records.size() > m_capacity) {
+            m_records.pop_front();
+        }
+    }
+
+    /**
+     * @brief 添加一条周期记录（sequence由此处分配）
+     */
+    void Add(CollectCycleRecord record) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        record.sequence = ++m_sequence;
+        if (m_records.size() >= m_capacity) {
+            m_records.pop_front();
+        }
+        m_records.push_back(record);
+    }
+
+    /**
+     * @brief 获取最近的周期记录（从旧到新）
+     *
+     * @param maxCount 最多返回的记录数，0表示全部
+     */
+    std::vector<CollectCycleRecord> GetRecent(size_t maxCount = 0) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t count = (maxCount == 0) ? m_records.size() : std::min(maxCount, m_records.size());
+        return std::vector<CollectCycleRecord>(m_records.end() - static_cast<std::ptrdiff_t>(count),
+                                               m_records.end());
+    }
+
+    /**
+     * @brief 汇总环中所有周期
+     */
+    CollectCycleSummary GetSummary() const {
+        std::vector<CollectCycleRecord> records = GetRecent();
+
+        CollectCycleSummary summary;
+        summary.cycles = records.size();
+        std::vector<uint64_t> totals;
+        totals.reserve(records.size());
+        for (const auto& record : records) {
+            totals.push_back(record.totalUs);
+            summary.refreshCycles += record.refresh ? 1 : 0;
+            summary.failedCycles += record.Failed() ? 1 : 0;
+        }
+        summary.totalUs = Summarize(totals);
+        summary.boardInfo = SummarizeEndpoint(records, &CollectCycleRecord::boardInfo);
+        summary.stackInfo = SummarizeEndpoint(records, &CollectCycleRecord::stackInfo);
+        return summary;
+    }
+
+private:
+    static CollectValueSummary Summarize(std::vector<uint64_t>& values) {
+        CollectValueSummary summary;
+        if (values.empty()) {
+            return summary;
+        }
+        std::sort(values.begin(), values.end());
+        uint64_t sum = 0;
+        for (uint64_t value : values) {
+            sum += value;
+        }
+        summary.samples = values.size();
+        summary.min = values.front();
+        summary.avg = sum / values.size();
+        // 最近秩：不小于99%样本的最小值
+        size_t rank = (values.size() * 99 + 99) / 100;
+        summary.p99 = values[std::max<size_t>(rank, 1) - 1];
+        return summary;
+    }
+
+    static CollectEndpointSummary SummarizeEndpoint(const std::vector<CollectCycleRecord>& records,
+                                                    CollectEndpointCycle CollectCycleRecord::*member) {
+        CollectEndpointSummary summary;
+        std::vector<uint64_t> fetch, parse, convert, commit, compressed, raw, changed;
+        for (const auto& record : records) {
+            const CollectEndpointCycle& cycle = record.*member;
+            switch (cycle.outcome) {
+                case CollectOutcome::NotCollected:
+                    continue;
+                case CollectOutcome::Applied:     summary.applied++; break;
+                case CollectOutcome::Unchanged:   summary.unchanged++; break;
+                case CollectOutcome::NotModified: summary.notModified++; break;
+                case CollectOutcome::FetchFailed: summary.fetchFailures++; break;
+                case CollectOutcome::ParseFailed: summary.parseFailures++; break;
+                case CollectOutcome::Exception:   summary.exceptions++; break;
+            }
+
+            fetch.push_back(cycle.fetchUs);
+            if (cycle.outcome == CollectOutcome::FetchFailed) {
+                continue;
+            }
+            compressed.push_back(cycle.compressedBytes);
+            raw.push_back(cycle.rawBytes);
+            if (cycle.outcome == CollectOutcome::Applied ||
+                cycle.outcome == CollectOutcome::ParseFailed ||
+                cycle.outcome == CollectOutcome::Exception) {
+                parse.push_back(cycle.parseUs);
+            }
+            if (cycle.outcome == CollectOutcome::Applied) {
+                convert.push_back(cycle.convertUs);
+                commit.push_back(cycle.commitUs);
+                changed.push_back(cycle.changedEntities);
+            }
+        }
+        summary.fetchUs = Summarize(fetch);
+        summary.parseUs = Summarize(parse);
+        summary.convertUs = Summarize(convert);
+        summary.commitUs = Summarize(commit);
+        summary.compressedBytes = Summarize(compressed);
+        summary.rawBytes = Summarize(raw);
+        summary.changedEntities = Summarize(changed);
+        return summary;
+    }
+
+    mutable std::mutex m_mutex;
+    size_t m_capacity;
+    std::deque<CollectCycleRecord> m_records;
+    uint64_t m_sequence = 0;
+};
+
+} // namespace zygl::infrastructure
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <random>
+
+namespace zygl::infrastructure {
+
+/**
+ * @brief CollectScheduler - 采集调度器（条件变量截止时间）
+ *
+ * 采集线程调用WaitForNext()等待下一个截止时间，采集完成后调用OnCycleFinished()报告结果，
+ * 调度器据此计算下一个截止时间：
+ * - 正常：按固定网格调度（上一个截止时间 + 间隔），采集耗时不累积漂移；
+ *   采集超时错过的网格点直接跳过，不会连续补采
+ * - 失败：指数退避（间隔 × 2^连续失败次数，不超过上限），并加入随机抖动，
+ *   避免后端故障期间按固定间隔反复请求、恢复时多个实例同时涌入
+ * - 快速轮询：RequestFastPoll()后的一段时间内按较短间隔采集（如部署/卸载之后），
+ *   并立即提前下一次采集；退避期间不提前
+ * - 即时刷新：RequestRefresh()请求一次网格之外的刷新（收到后端推送通知时），
+ *   不改变网格和退避状态。刷新开始之前的多次请求合并为一次；刷新进行中到达的请求
+ *   在其结束后再合并为一次；两次刷新的开始时间至少间隔最小刷新间隔，避免通知风暴
+ *   持续占用后端。到达截止时间的正常采集同时满足等待中的刷新请求
+ *
+ * Stop()、RequestFastPoll()和RequestRefresh()通过条件变量立即唤醒等待中的采集线程。
+ *
+ * 线程安全：
+ * - 所有方法都可以被任意线程并发调用（WaitForNext/OnCycleFinished应由同一个采集线程调用）
+ */
+class CollectScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 采集周期类型
+     */
+    enum class CycleKind {
+        Scheduled,      // 到达截止时间的正常采集（结束后调用OnCycleFinished）
+        Refresh         // RequestRefresh()触发的即时刷新（不影响调度状态）
+    };
+
+    /**
+     * @brief 构造函数
+     *
+     * @param interval 正常采集间隔
+     */
+    explicit CollectScheduler(std::chrono::milliseconds interval)
+        : m_interval(ClampInterval(interval)),
+          m_random(std::random_device{}()) {
+    }
+
+    // 禁止拷贝
+    CollectScheduler(const CollectScheduler&) = delete;
+    CollectScheduler& operator=(const CollectScheduler&) = delete;
+
+    /**
+     * @brief 设置正常采集间隔
+     */
+    void SetInterval(std::chrono::milliseconds interval) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_interval = ClampInterval(interval);
+    }
+
+    /**
+     * @brief 设置快速轮询参数
+     *
+     * @param interval 快速轮询间隔
+     * @param duration 每次RequestFastPoll()后的快速轮询时长，0表示禁用快速轮询
+     */
+    void SetFastPoll(std::chrono::milliseconds interval, std::chrono::milliseconds duration) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fastInterval = ClampInterval(interval);
+        m_fastDuration = std::max(duration, std::chrono::milliseconds(0));
+    }
+
+    /**
+     * @brief 设置退避上限
+     */
+    void SetMaxBackoff(std::chrono::milliseconds maxBackoff) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_maxBackoff = ClampInterval(maxBackoff);
+    }
+
+    /**
+     * @brief 设置两次即时刷新之间的最小间隔（0表示不限制）
+     */
+    void SetMinRefreshInterval(std::chrono::milliseconds interval) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_minRefreshInterval = std::max(interval, std::chrono::milliseconds(0));
+    }
+
+    /**
+     * @brief 开始调度（第一次采集立即进行）
+     */
+    void Start() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopped = false;
+        m_consecutiveFailures = 0;
+        m_nextDeadline = Clock::now();
+    }
+
+    /**
+     * @brief 停止调度，立即唤醒等待中的采集线程
+     */
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopped = true;
+        }
+        m_cv.notify_all();
+    }
+
+    /**
+     * @brief 等待下一个截止时间或即时刷新请求
+     *
+     * @param kind 输出：应执行的采集周期类型
+     * @return true 应执行一次采集；false 调度已停止
+     */
+    bool WaitForNext(CycleKind& kind) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stopped) {
+            auto now = Clock::now();
+            auto wakeAt = m_nextDeadline;
+            if (now >= wakeAt) {
+                m_scheduledAt = wakeAt;
+                m_refreshPending = false;  // 本次采集在请求之后开始，同时满足刷新请求
+                kind = CycleKind::Scheduled;
+                return true;
+            }
+            if (m_refreshPending) {
+                auto refreshAt = m_lastRefreshAt + m_minRefreshInterval;
+                if (now >= refreshAt) {
+                    m_refreshPending = false;
+                    m_lastRefreshAt = now;
+                    m_refreshCycles++;
+                    kind = CycleKind::Refresh;
+                    return true;
+                }
+                wakeAt = std::min(wakeAt, refreshAt);
+            }
+            m_cv.wait_until(lock, wakeAt);
+        }
+        return false;
+    }
+
+    /**
+     * @brief 报告一次采集的结果，计算下一个截止时间
+     *
+     * @param success 本次采集是否成功
+     */
+    void OnCycleFinished(bool success) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto now = Clock::now();
+
+        if (!success) {
+            m_consecutiveFailures = std::min<uint32_t>(m_consecutiveFailures + 1, MAX_BACKOFF_EXPONENT);
+            m_nextDeadline = now + BackoffDelay();
+            return;
+        }
+
+        if (m_consecutiveFailures > 0) {
+            // 从故障中恢复：以当前时刻重新建立网格
+            m_consecutiveFailures = 0;
+            m_scheduledAt = now;
+        }
+
+        auto interval = now < m_fastUntil ? m_fastInterval : m_interval;
+        auto next = m_scheduledAt + interval;
+        if (next <= now) {
+            // 采集耗时超过间隔：跳过错过的网格点，保持相位不变
+            auto missed = (now - next) / interval + 1;
+            next += interval * missed;
+        }
+        m_nextDeadline = next;
+    }
+
+    /**
+     * @brief 进入快速轮询期（如部署/卸载之后）
+     *
+     * 快速轮询期内按快速间隔采集，下一次采集提前到快速间隔之后；
+     * 后端故障退避期间只延长快速轮询期，不提前采集。
+     */
+    void RequestFastPoll() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_fastDuration.count() == 0) {
+                return;
+            }
+            auto now = Clock::now();
+            m_fastUntil = now + m_fastDuration;
+            m_fastPollRequests++;
+            if (m_consecutiveFailures > 0) {
+                return;
+            }
+            auto fastDeadline = now + m_fastInterval;
+            if (m_nextDeadline > fastDeadline) {
+                m_nextDeadline = fastDeadline;
+            }
+        }
+        m_cv.notify_all();
+    }
+
+    /**
+     * @brief 请求一次即时刷新（与尚未开始的刷新请求合并）
+     */
+    void RequestRefresh() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_refreshPending = true;
+        }
+        m_cv.notify_all();
+    }
+
+    /**
+     * @brief 获取连续失败次数（0表示正常）
+     */
+    uint32_t GetConsecutiveFailures() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_consecutiveFailures;
+    }
+
+    /**
+     * @brief 当前是否处于快速轮询期
+     */
+    bool IsFastPolling() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return Clock::now() < m_fastUntil;
+    }
+
+    /**
+     * @brief 获取快速轮询请求次数
+     */
+    uint64_t GetFastPollRequestCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_fastPollRequests;
+    }
+
+    /**
+     * @brief 获取已执行的即时刷新次数（合并后）
+     */
+    uint64_t GetRefreshCycleCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_refreshCycles;
+    }
+
+    /**
+     * @brief 距下一次采集的时间（已停止或已到期时为0）
+     */
+    std::chrono::milliseconds GetTimeUntilNext() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto now = Clock::now();
+        if (m_stopped || m_nextDeadline <= now) {
+            return std::chrono::milliseconds(0);
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(m_nextDeadline - now);
+    }
+
+private:
+    static constexpr uint32_t MAX_BACKOFF_EXPONENT = 16;
+
+    static std::chrono::milliseconds ClampInterval(std::chrono::milliseconds interval) {
+        return std::max(interval, std::chrono::milliseconds(1));
+    }
+
+    /**
+     * @brief 计算退避时间（调用方持有锁）
+     *
+     * 基准为 间隔 × 2^(连续失败次数-1)，不超过上限；实际等待在[基准/2, 基准]内均匀随机。
+     */
+    Clock::duration BackoffDelay() {
+        auto base = m_interval;
+        for (uint32_t i = 1; i < m_consecutiveFailures && base < m_maxBackoff; ++i) {
+            base *= 2;
+        }
+        base = std::min(base, m_maxBackoff);
+
+        std::uniform_int_distribution<int64_t> jitter(base.count() / 2, base.count());
+        return std::chrono::milliseconds(jitter(m_random));
+    }
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+
+    std::chrono::milliseconds m_interval;                                   // 正常间隔
+    std::chrono::milliseconds m_fastInterval{1000};                         // 快速轮询间隔
+    std::chrono::milliseconds m_fastDuration{30000};                        // 快速轮询时长
+    std::chrono::milliseconds m_maxBackoff{60000};                          // 退避上限
+    std::chrono::milliseconds m_minRefreshInterval{200};                    // 即时刷新最小间隔
+
+    bool m_stopped = true;
+    Clock::time_point m_nextDeadline = Clock::now();                        // 下一次采集的截止时间
+    Clock::time_point m_scheduledAt = Clock::now();                         // 当前采集对应的网格点
+    Clock::time_point m_fastUntil{};                                        // 快速轮询期结束时间
+    uint32_t m_consecutiveFailures = 0;
+    uint64_t m_fastPollRequests = 0;
+    bool m_refreshPending = false;                                          // 有尚未开始的刷新请求
+    Clock::time_point m_lastRefreshAt{};                                    // 上一次即时刷新的开始时间
+    uint64_t m_refreshCycles = 0;
+    std::mt19937_64 m_random;                                               // 退避抖动
+};
+
+} // namespace zygl::infrastructure
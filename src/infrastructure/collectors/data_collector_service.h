@@ -7,16 +7,56 @@
 #include "../../domain/service.h"
 #include "../../domain/task.h"
 #include "../api_client/qyw_api_client.h"
+#include "../api_client/stack_info_sax_parser.h"
+#include "../metrics/latency_histogram.h"
+#include "collect_scheduler.h"
+#include "collect_cycle_stats.h"
 #include <memory>
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <future>
+#include <mutex>
+#include <system_error>
 #include <set>
 #include <string>
+#include <cstring>
 #include <unordered_map>
 
 namespace zygl::infrastructure {
 
+/**
+ * @brief 采集接口
+ */
+enum class CollectEndpoint {
+    BoardInfo,      // GET /boardinfo
+    StackInfo       // GET /stackinfo
+};
+
+/**
+ * @brief 单个采集接口的统计快照（单位：微秒）
+ *
+ * fetch：HTTP请求到收完响应体；parse：JSON解析；convert：转换为领域对象并统计变化；
+ * commit：写入仓储。响应与上次写入的相同时跳过解析和写入，不记录parse/convert/commit耗时。
+ * 逐周期的明细和最近N个周期的汇总见CollectCycleHistory。
+ */
+struct CollectEndpointStats {
+    uint64_t successCount = 0;      // 成功次数（包括未变化而跳过的次数）
+    uint64_t failureCount = 0;      // 失败次数（请求失败或解析失败）
+    uint64_t unchangedCount = 0;    // 响应体哈希与上次相同而跳过的次数
+    uint64_t notModifiedCount = 0;  // 后端回复304而跳过的次数
+    uint64_t compressedBytes = 0;   // 累计传输的响应体字节数（压缩传输时为压缩后的大小）
+    uint64_t rawBytes = 0;          // 累计解压后的响应体字节数
+    uint64_t lastFetchUs = 0;       // 最近一次拉取耗时
+    uint64_t lastParseUs = 0;       // 最近一次解析耗时
+    uint64_t lastConvertUs = 0;     // 最近一次转换耗时
+    uint64_t lastCommitUs = 0;      // 最近一次写入仓储耗时
+    LatencySummary fetchLatency;    // 拉取耗时分布
+    LatencySummary parseLatency;    // 解析耗时分布
+    LatencySummary convertLatency;  // 转换耗时分布
+    LatencySummary commitLatency;   // 写入仓储耗时分布
+};
+
 /**
  * @brief DataCollectorService - 数据采集服务
  * 
@@ -25,13 +65,36 @@ namespace zygl::infrastructure {
  * 2. 将API数据转换为领域对象
  * 3. 更新内存仓储（双缓冲机制）
  * 
- * 工作流程：
- * 1. 拉取boardinfo，更新Chassis聚合（非活动缓冲）
- * 2. 拉取stackinfo，更新Stack聚合
- * 3. 原子交换Chassis仓储的活动缓冲指针
+ * 工作流程（每个采集周期两个接口并发进行）：
+ * 1. 拉取boardinfo，收到后立即解析，更新Chassis聚合（双缓冲交换）和任务位置索引
+ * 2. 同时在辅助线程拉取stackinfo，收到后立即解析，更新Stack聚合
+ * 3. 两者都完成后本周期结束，周期耗时取决于较慢的接口而不是两者之和
+ * 
+ * 两个接口各用一条独立的HTTP连接；两个仓储内部各自加锁，
+ * 任务位置索引在任一方更新后都会重新关联，因此两者的完成顺序不影响结果。
+ * 每个接口的拉取/解析/转换/写入耗时分别统计，见GetEndpointStats()；
+ * 每个周期结束后记录一条CollectCycleRecord（各阶段耗时、字节数、实体数、变化数、失败原因），
+ * 保存在最近N个周期的记录环中，见GetCycleHistory()。
+ * 
+ * 未变化的响应（两个周期之间通常完全相同）不重复解析和写入：
+ * - 每个接口记录上次成功写入的响应体哈希（FNV-1a 64位），相同时直接结束本次采集
+ * - 后端返回ETag时，下次请求携带If-None-Match，后端回复304时连响应体也不用传输
+ * 只有成功写入仓储后才更新记录的哈希/ETag，解析或写入失败时下个周期会重新处理。
+ * 
+ * 采集时机由CollectScheduler决定（条件变量截止时间，Stop()立即生效）：
+ * - 正常按固定网格采集，不随采集耗时漂移
+ * - 任一接口失败时指数退避（带抖动），恢复后回到正常间隔
+ * - RequestFastPoll()后一段时间内按快速间隔采集（部署/卸载后）
+ * - RequestRefresh()立即刷新指定接口（收到后端推送通知时），多个请求合并为一次刷新
+ * 
+ * 即时刷新只采集被请求的接口，并且不使用304/哈希跳过：推送通知意味着后端数据已变化，
+ * 刷新总是以后端的完整响应重新写入仓储。
+ * 
+ * 机箱仓储只由采集线程写入（双缓冲单写入者）：板卡上下线通知经QueueBoardPresence()排队，
+ * 采集线程在下一个周期开始时先写入在线状态，再由boardinfo刷新写入完整信息。
  * 
  * 线程模型：
- * - 运行在独立的后台线程中
+ * - 运行在独立的后台线程中（stackinfo在每个周期的辅助线程中采集）
  * - 可以安全启动和停止
  */
 class DataCollectorService {
@@ -51,8 +114,8 @@ class DataCollectorService {
         : m_apiClient(apiClient),
           m_chassisRepo(chassisRepo),
           m_stackRepo(stackRepo),
-          m_intervalSeconds(intervalSeconds),
-          m_running(false) {
+          m_running(false),
+          m_scheduler(std::chrono::seconds(intervalSeconds)) {
     }
 
     /**
@@ -74,6 +137,7 @@ class DataCollectorService {
             return;  // 已经在运行
         }
         
+        m_scheduler.Start();
         m_thread = std::thread(&DataCollectorService::CollectLoop, this);
     }
 
@@ -85,6 +149,7 @@ class DataCollectorService {
             return;  // 已经停止
         }
         
+        m_scheduler.Stop();  // 立即唤醒等待中的采集线程
         if (m_thread.joinable()) {
             m_thread.join();
         }
@@ -101,8 +166,7 @@ class DataCollectorService {
      * @brief 手动触发一次采集（用于测试）
      */
     void CollectOnce() {
-        CollectBoardInfo();
-        CollectStackInfo();
+        CollectCycle();
     }
 
     /**
@@ -110,47 +174,459 @@ class DataCollectorService {
      * @param intervalSeconds 间隔秒数
      */
     void SetInterval(int intervalSeconds) {
-        m_intervalSeconds = intervalSeconds;
+        m_scheduler.SetInterval(std::chrono::seconds(intervalSeconds));
+    }
+
+    /**
+     * @brief 设置快速轮询参数
+     * @param interval 快速轮询间隔
+     * @param duration 每次RequestFastPoll()后的快速轮询时长，0表示禁用
+     */
+    void SetFastPoll(std::chrono::milliseconds interval, std::chrono::milliseconds duration) {
+        m_scheduler.SetFastPoll(interval, duration);
+    }
+
+    /**
+     * @brief 设置失败退避上限
+     */
+    void SetMaxBackoff(std::chrono::milliseconds maxBackoff) {
+        m_scheduler.SetMaxBackoff(maxBackoff);
+    }
+
+    /**
+     * @brief 设置两次即时刷新之间的最小间隔（0表示不限制）
+     */
+    void SetMinRefreshInterval(std::chrono::milliseconds interval) {
+        m_scheduler.SetMinRefreshInterval(interval);
+    }
+
+    /**
+     * @brief 请求尽快刷新并在一段时间内快速轮询（部署/卸载后调用）
+     *
+     * 只唤醒采集线程，可以在任意线程调用（包括命令执行线程和Webhook线程）。
+     */
+    void RequestFastPoll() {
+        m_scheduler.RequestFastPoll();
+    }
+
+    /**
+     * @brief 请求立即刷新单个接口（收到后端推送的状态变化通知时调用）
+     *
+     * 尚未开始的刷新请求合并为一次，只采集被请求过的接口。
+     * 只唤醒采集线程，可以在任意线程调用。
+     */
+    void RequestRefresh(CollectEndpoint endpoint) {
+        m_refreshRequests.fetch_add(1, std::memory_order_relaxed);
+        m_pendingRefresh.fetch_or(EndpointBit(endpoint), std::memory_order_acq_rel);
+        m_scheduler.RequestRefresh();
+    }
+
+    /**
+     * @brief 提交板卡上下线通知（收到后端推送时调用）
+     *
+     * 通知先排队（同一板卡只保留最后一次），采集线程在下一次刷新开始时写入机箱仓储，
+     * 状态广播随之推送，之后的boardinfo刷新再写入任务等完整信息。可以在任意线程调用。
+     */
+    void QueueBoardPresence(const std::string& boardAddress, bool online) {
+        {
+            std::lock_guard<std::mutex> lock(m_presenceMutex);
+            m_pendingPresence[boardAddress] = online;
+        }
+        RequestRefresh(CollectEndpoint::BoardInfo);
+    }
+
+    /**
+     * @brief 获取调度状态：连续失败次数（>0表示正在退避）/ 是否处于快速轮询期
+     */
+    uint32_t GetConsecutiveFailures() const { return m_scheduler.GetConsecutiveFailures(); }
+    bool IsFastPolling() const { return m_scheduler.IsFastPolling(); }
+
+    /**
+     * @brief 获取即时刷新统计：请求次数 / 合并后实际执行的刷新次数
+     */
+    uint64_t GetRefreshRequestCount() const { return m_refreshRequests.load(std::memory_order_relaxed); }
+    uint64_t GetRefreshCycleCount() const { return m_scheduler.GetRefreshCycleCount(); }
+
+    /**
+     * @brief 获取单个接口的拉取/解析/写入耗时统计
+     */
+    CollectEndpointStats GetEndpointStats(CollectEndpoint endpoint) const {
+        const EndpointMetrics& metrics = MetricsOf(endpoint);
+        CollectEndpointStats stats;
+        stats.successCount = metrics.successCount.load(std::memory_order_relaxed);
+        stats.failureCount = metrics.failureCount.load(std::memory_order_relaxed);
+        stats.unchangedCount = metrics.unchangedCount.load(std::memory_order_relaxed);
+        stats.notModifiedCount = metrics.notModifiedCount.load(std::memory_order_relaxed);
+        stats.compressedBytes = metrics.compressedBytes.load(std::memory_order_relaxed);
+        stats.rawBytes = metrics.rawBytes.load(std::memory_order_relaxed);
+        stats.lastFetchUs = metrics.lastFetchUs.load(std::memory_order_relaxed);
+        stats.lastParseUs = metrics.lastParseUs.load(std::memory_order_relaxed);
+        stats.lastConvertUs = metrics.lastConvertUs.load(std::memory_order_relaxed);
+        stats.lastCommitUs = metrics.lastCommitUs.load(std::memory_order_relaxed);
+        stats.fetchLatency = metrics.fetchLatency.GetSummary();
+        stats.parseLatency = metrics.parseLatency.GetSummary();
+        stats.convertLatency = metrics.convertLatency.GetSummary();
+        stats.commitLatency = metrics.commitLatency.GetSummary();
+        return stats;
+    }
+
+    /**
+     * @brief 获取最近N个采集周期的记录环（供应用层查询，生命周期与采集服务无关）
+     */
+    std::shared_ptr<const CollectCycleHistory> GetCycleHistory() const {
+        return m_cycleHistory;
+    }
+
+    /**
+     * @brief 获取最近的采集周期记录（从旧到新，maxCount为0表示全部）
+     */
+    std::vector<CollectCycleRecord> GetRecentCycles(size_t maxCount = 0) const {
+        return m_cycleHistory->GetRecent(maxCount);
+    }
+
+    /**
+     * @brief 获取最近N个采集周期的汇总（各阶段最小值/平均值/99分位）
+     */
+    CollectCycleSummary GetCycleSummary() const {
+        return m_cycleHistory->GetSummary();
+    }
+
+    /**
+     * @brief 设置保存的采集周期数
+     */
+    void SetCycleHistorySize(size_t size) {
+        m_cycleHistory->SetCapacity(size);
+    }
+
+    /**
+     * @brief 获取最近一个采集周期的耗时（微秒，两个接口都完成为止）
+     */
+    uint64_t GetLastCycleMicros() const {
+        return m_lastCycleUs.load(std::memory_order_relaxed);
     }
 
 private:
+    /**
+     * @brief 单个接口的统计
+     */
+    struct EndpointMetrics {
+        std::atomic<uint64_t> successCount{0};
+        std::atomic<uint64_t> failureCount{0};
+        std::atomic<uint64_t> unchangedCount{0};
+        std::atomic<uint64_t> notModifiedCount{0};
+        std::atomic<uint64_t> compressedBytes{0};
+        std::atomic<uint64_t> rawBytes{0};
+        std::atomic<uint64_t> lastFetchUs{0};
+        std::atomic<uint64_t> lastParseUs{0};
+        std::atomic<uint64_t> lastConvertUs{0};
+        std::atomic<uint64_t> lastCommitUs{0};
+        LatencyHistogram fetchLatency;
+        LatencyHistogram parseLatency;
+        LatencyHistogram convertLatency;
+        LatencyHistogram commitLatency;
+    };
+
+    static uint32_t EndpointBit(CollectEndpoint endpoint) {
+        return endpoint == CollectEndpoint::BoardInfo ? 1u : 2u;
+    }
+
+    EndpointMetrics& MetricsOf(CollectEndpoint endpoint) {
+        return endpoint == CollectEndpoint::BoardInfo ? m_boardInfoMetrics : m_stackInfoMetrics;
+    }
+
+    const EndpointMetrics& MetricsOf(CollectEndpoint endpoint) const {
+        return endpoint == CollectEndpoint::BoardInfo ? m_boardInfoMetrics : m_stackInfoMetrics;
+    }
+
+    /**
+     * @brief 单个接口上次成功写入仓储的响应（只由采集该接口的线程访问）
+     */
+    struct PayloadState {
+        bool valid = false;         // 是否已有成功写入的响应
+        uint64_t hash = 0;          // 响应体哈希
+        std::string etag;           // 响应的ETag（用于If-None-Match）
+    };
+
+    /**
+     * @brief 计算响应体的FNV-1a 64位哈希
+     */
+    static uint64_t HashBody(const std::string& body) {
+        return HashBytes(FNV_OFFSET_BASIS, body.data(), body.size());
+    }
+
+    static constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+
+    /**
+     * @brief 将一段字节累加到FNV-1a 64位哈希
+     */
+    static uint64_t HashBytes(uint64_t hash, const void* data, size_t length) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief 板卡状态指纹：运行状态、任务数、任务ID/状态（用于统计变化的板卡数）
+     */
+    static uint64_t BoardFingerprint(const domain::Board& board) {
+        int32_t status = static_cast<int32_t>(board.GetStatus());
+        int32_t taskCount = board.GetTaskCount();
+        uint64_t hash = HashBytes(FNV_OFFSET_BASIS, &status, sizeof(status));
+        hash = HashBytes(hash, &taskCount, sizeof(taskCount));
+        const auto& tasks = board.GetTasks();
+        for (int32_t i = 0; i < taskCount && i < static_cast<int32_t>(tasks.size()); ++i) {
+            hash = HashBytes(hash, tasks[i].taskID, std::strlen(tasks[i].taskID) + 1);
+            hash = HashBytes(hash, tasks[i].taskStatus, std::strlen(tasks[i].taskStatus) + 1);
+        }
+        return hash;
+    }
+
+    /**
+     * @brief 业务链路状态指纹：部署/运行状态、组件UUID/状态、任务ID/状态/所在板卡（不含资源使用率）
+     */
+    static uint64_t StackFingerprint(const domain::Stack& stack) {
+        auto hashString = [](uint64_t hash, const std::string& value) {
+            return HashBytes(hash, value.c_str(), value.size() + 1);
+        };
+        int32_t states[2] = {static_cast<int32_t>(stack.GetDeployStatus()),
+                             static_cast<int32_t>(stack.GetRunningStatus())};
+        uint64_t hash = HashBytes(FNV_OFFSET_BASIS, states, sizeof(states));
+        for (const auto& [serviceUUID, service] : stack.GetAllServices()) {
+            int32_t serviceStatus = static_cast<int32_t>(service.GetStatus());
+            hash = hashString(hash, serviceUUID);
+            hash = HashBytes(hash, &serviceStatus, sizeof(serviceStatus));
+            for (const auto& [taskID, task] : service.GetAllTasks()) {
+                hash = hashString(hash, taskID);
+                hash = hashString(hash, task.GetTaskStatus());
+                hash = hashString(hash, task.GetBoardAddress());
+            }
+        }
+        return hash;
+    }
+
+    /**
+     * @brief 累计响应体的传输字节数和解压后字节数，并记入本周期明细
+     */
+    static void RecordBytes(EndpointMetrics& metrics, const FetchedBody& fetched, CollectEndpointCycle& cycle) {
+        cycle.compressedBytes = fetched.wireBytes;
+        cycle.rawBytes = fetched.body.size();
+        metrics.compressedBytes.fetch_add(fetched.wireBytes, std::memory_order_relaxed);
+        metrics.rawBytes.fetch_add(fetched.body.size(), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 判断响应是否与上次写入的相同（304或哈希相同），相同时计为成功并返回true
+     *
+     * @param bodyHash 输出：响应体哈希（返回false时用于提交）
+     * @param cycle 输出：相同时记录本周期结果
+     */
+    static bool IsUnchanged(EndpointMetrics& metrics, PayloadState& last,
+                            const FetchedBody& fetched, uint64_t& bodyHash,
+                            CollectEndpointCycle& cycle) {
+        if (fetched.notModified) {
+            cycle.outcome = CollectOutcome::NotModified;
+            metrics.notModifiedCount.fetch_add(1, std::memory_order_relaxed);
+            metrics.successCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bodyHash = HashBody(fetched.body);
+        if (last.valid && last.hash == bodyHash) {
+            last.etag = fetched.etag;  // 内容相同但ETag可能变化
+            cycle.outcome = CollectOutcome::Unchanged;
+            metrics.unchangedCount.fetch_add(1, std::memory_order_relaxed);
+            metrics.successCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 响应成功写入仓储后记录其哈希和ETag
+     */
+    static void CommitPayload(PayloadState& last, uint64_t bodyHash, std::string etag) {
+        last.valid = true;
+        last.hash = bodyHash;
+        last.etag = std::move(etag);
+    }
+
+    /**
+     * @brief 记录一段耗时（从since到现在），返回当前时刻作为下一段的起点
+     *
+     * @param cycleUs 输出：本周期明细中对应阶段的耗时
+     */
+    static std::chrono::steady_clock::time_point RecordPhase(
+        LatencyHistogram& histogram, std::atomic<uint64_t>& last, uint64_t& cycleUs,
+        std::chrono::steady_clock::time_point since) {
+        auto now = std::chrono::steady_clock::now();
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(now - since).count();
+        histogram.Record(static_cast<uint64_t>(micros));
+        last.store(static_cast<uint64_t>(micros), std::memory_order_relaxed);
+        cycleUs = static_cast<uint64_t>(micros);
+        return now;
+    }
+
+    /**
+     * @brief 执行一个采集周期：boardinfo在当前线程，stackinfo在辅助线程，并发拉取
+     *
+     * 周期结束后将明细记入采集周期记录环。
+     *
+     * @param boards 是否采集boardinfo
+     * @param stacks 是否采集stackinfo
+     * @param refresh 为true时为即时刷新（不跳过未变化的响应）
+     * @return true 如果采集的接口都成功
+     */
+    bool CollectCycle(bool boards = true, bool stacks = true, bool refresh = false) {
+        auto startedAt = std::chrono::steady_clock::now();
+        CollectCycleRecord record;
+        record.refresh = refresh;
+        record.startedAtMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        std::future<bool> stackInfoTask;
+        if (boards && stacks) {
+            try {
+                stackInfoTask = std::async(std::launch::async, [this, refresh, &record]() {
+                    return CollectStackInfo(record.stackInfo, refresh);
+                });
+            } catch (const std::system_error& e) {
+                // 无法创建线程时退化为串行采集
+                std::cerr << "DataCollectorService: 无法并发采集 - " << e.what() << std::endl;
+            }
+        }
+
+        bool boardInfoOk = !boards || CollectBoardInfo(record.boardInfo, refresh);
+        bool stackInfoOk = true;
+        if (stackInfoTask.valid()) {
+            stackInfoOk = stackInfoTask.get();
+        } else if (stacks) {
+            stackInfoOk = CollectStackInfo(record.stackInfo, refresh);
+        }
+
+        record.totalUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startedAt).count());
+        record.boardCount = m_boardCount;
+        record.stackCount = m_stackCount;
+        record.serviceCount = m_serviceCount;
+        record.taskCount = m_taskCount;
+        m_cycleHistory->Add(record);
+
+        m_lastCycleUs.store(record.totalUs, std::memory_order_relaxed);
+        return boardInfoOk && stackInfoOk;
+    }
+
     /**
      * @brief 采集循环（运行在后台线程）
      */
     void CollectLoop() {
-        while (m_running.load()) {
-            // 执行采集
-            CollectBoardInfo();
-            CollectStackInfo();
-            
-            // 等待下一次采集
-            auto start = std::chrono::steady_clock::now();
-            while (m_running.load()) {
-                auto elapsed = std::chrono::steady_clock::now() - start;
-                auto elapsedSeconds = std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
-                
-                if (elapsedSeconds >= m_intervalSeconds) {
-                    break;
+        CollectScheduler::CycleKind kind;
+        while (m_scheduler.WaitForNext(kind)) {
+            ApplyPendingPresence();
+            if (kind == CollectScheduler::CycleKind::Refresh) {
+                CollectRefresh();
+                continue;
+            }
+            // 正常采集同时满足已到达的刷新请求
+            m_pendingRefresh.store(0, std::memory_order_release);
+            // 执行采集（两个接口并发），结果决定下一次采集时间（正常/快速/退避）
+            m_scheduler.OnCycleFinished(CollectCycle());
+        }
+    }
+
+    /**
+     * @brief 即时刷新：只采集被请求过的接口，失败不影响调度（下一次正常采集会重试）
+     */
+    void CollectRefresh() {
+        uint32_t pending = m_pendingRefresh.exchange(0, std::memory_order_acq_rel);
+        bool boards = (pending & EndpointBit(CollectEndpoint::BoardInfo)) != 0;
+        bool stacks = (pending & EndpointBit(CollectEndpoint::StackInfo)) != 0;
+        if (boards || stacks) {
+            CollectCycle(boards, stacks, true);
+        }
+    }
+
+    /**
+     * @brief 将排队的板卡上下线写入机箱仓储（采集线程在每个周期开始时调用）
+     *
+     * 在线状态实际变化时才提交（一次SaveAll）。
+     */
+    void ApplyPendingPresence() {
+        std::unordered_map<std::string, bool> pending;
+        {
+            std::lock_guard<std::mutex> lock(m_presenceMutex);
+            pending.swap(m_pendingPresence);
+        }
+        if (pending.empty()) {
+            return;
+        }
+
+        auto allChassisPtr = std::make_unique<std::array<domain::Chassis, domain::TOTAL_CHASSIS_COUNT>>(
+            m_chassisRepo->GetAll()
+        );
+        bool changed = false;
+        for (auto& chassis : *allChassisPtr) {
+            if (chassis.GetChassisNumber() == 0) {
+                continue;
+            }
+            for (auto& board : chassis.GetAllBoards()) {
+                auto it = pending.find(board.GetBoardAddress());
+                if (it == pending.end() || board.IsOnline() == it->second) {
+                    continue;
                 }
-                
-                // 短暂睡眠，避免CPU占用
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                if (it->second) {
+                    board.MarkAsOnline();
+                } else {
+                    board.MarkAsOffline();
+                }
+                changed = true;
             }
         }
+        if (changed) {
+            m_chassisRepo->SaveAll(*allChassisPtr);
+        }
     }
 
     /**
      * @brief 采集板卡信息
      * 
      * 从API获取板卡数据，更新Chassis聚合
+     * 
+     * @param cycle 输出：本周期该接口的明细
+     * @param force 为true时不跳过未变化的响应
      */
-    void CollectBoardInfo() {
+    bool CollectBoardInfo(CollectEndpointCycle& cycle, bool force = false) {
+        EndpointMetrics& metrics = m_boardInfoMetrics;
         try {
-            // 1. 调用API
-            auto boardInfosOpt = m_apiClient->GetBoardInfo();
-            if (!boardInfosOpt.has_value()) {
+            // 1. 调用API，收到后立即解析
+            auto phaseStart = std::chrono::steady_clock::now();
+            auto fetched = m_apiClient->FetchBoardInfoBody(force ? std::string() : m_boardInfoPayload.etag);
+            phaseStart = RecordPhase(metrics.fetchLatency, metrics.lastFetchUs, cycle.fetchUs, phaseStart);
+            if (!fetched.has_value()) {
                 // API调用失败，跳过本次采集
-                return;
+                cycle.outcome = CollectOutcome::FetchFailed;
+                metrics.failureCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            RecordBytes(metrics, fetched.value(), cycle);
+
+            // 与上次写入的相同则跳过解析和写入
+            uint64_t bodyHash = 0;
+            if (!force && IsUnchanged(metrics, m_boardInfoPayload, fetched.value(), bodyHash, cycle)) {
+                return true;
+            }
+            if (force) {
+                bodyHash = HashBody(fetched->body);
+            }
+
+            auto boardInfosOpt = m_apiClient->ParseBoardInfo(fetched->body);
+            phaseStart = RecordPhase(metrics.parseLatency, metrics.lastParseUs, cycle.parseUs, phaseStart);
+            if (!boardInfosOpt.has_value()) {
+                cycle.outcome = CollectOutcome::ParseFailed;
+                metrics.failureCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
             }
             
             const auto& boardInfos = boardInfosOpt.value();
@@ -169,7 +645,8 @@ class DataCollectorService {
                 boardInfoMap[boardInfo.boardAddress] = &boardInfo;
             }
         
-            // 4. 更新每个机箱中的板卡状态
+            // 4. 更新每个机箱中的板卡状态（同时统计状态变化的板卡数）
+            uint32_t changedBoards = 0;
             for (auto& chassis : allChassis) {
                 if (chassis.GetChassisNumber() == 0) {
                     continue;  // 跳过未初始化的机箱
@@ -178,6 +655,7 @@ class DataCollectorService {
                 auto& boards = chassis.GetAllBoards();
                 for (auto& board : boards) {
                     std::string boardAddr(board.GetBoardAddress());
+                    uint64_t before = BoardFingerprint(board);
                 
                     // O(1)查找板卡信息
                     auto it = boardInfoMap.find(boardAddr);
@@ -190,15 +668,36 @@ class DataCollectorService {
                         // 未找到，标记为离线
                         board.MarkAsOffline();
                     }
+                    if (BoardFingerprint(board) != before) {
+                        changedBoards++;
+                    }
                 }
             }
+            phaseStart = RecordPhase(metrics.convertLatency, metrics.lastConvertUs, cycle.convertUs, phaseStart);
             
             // 5. 原子性地提交所有更新（双缓冲交换）
             m_chassisRepo->SaveAll(allChassis);
+            
+            // 6. 更新任务位置索引（机箱/板卡/任务序号 -> 任务，用于F005H任务查看）
+            m_stackRepo->UpdateTaskPlacement(allChassis);
+
+            RecordPhase(metrics.commitLatency, metrics.lastCommitUs, cycle.commitUs, phaseStart);
+            CommitPayload(m_boardInfoPayload, bodyHash, std::move(fetched->etag));
+            cycle.outcome = CollectOutcome::Applied;
+            cycle.changedEntities = changedBoards;
+            m_boardCount = static_cast<uint32_t>(boardInfos.size());
+            metrics.successCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
         } catch (const std::exception& e) {
+            cycle.outcome = CollectOutcome::Exception;
+            metrics.failureCount.fetch_add(1, std::memory_order_relaxed);
             std::cerr << "CollectBoardInfo: 异常 - " << e.what() << std::endl;
+            return false;
         } catch (...) {
+            cycle.outcome = CollectOutcome::Exception;
+            metrics.failureCount.fetch_add(1, std::memory_order_relaxed);
             std::cerr << "CollectBoardInfo: 未知异常" << std::endl;
+            return false;
         }
     }
 
@@ -206,30 +705,89 @@ class DataCollectorService {
      * @brief 采集业务链路信息
      * 
      * 从API获取业务链路数据，更新Stack聚合
+     * 
+     * @param cycle 输出：本周期该接口的明细
+     * @param force 为true时不跳过未变化的响应
+     * @return true 如果成功（包括响应未变化而跳过）
      */
-    void CollectStackInfo() {
+    bool CollectStackInfo(CollectEndpointCycle& cycle, bool force = false) {
+        EndpointMetrics& metrics = m_stackInfoMetrics;
         try {
-            // 1. 调用API
-            auto stackInfosOpt = m_apiClient->GetStackInfo();
-            if (!stackInfosOpt.has_value()) {
-                return;
+            // 1. 调用API，收到后立即解析
+            auto phaseStart = std::chrono::steady_clock::now();
+            auto fetched = m_apiClient->FetchStackInfoBody(force ? std::string() : m_stackInfoPayload.etag);
+            phaseStart = RecordPhase(metrics.fetchLatency, metrics.lastFetchUs, cycle.fetchUs, phaseStart);
+            if (!fetched.has_value()) {
+                cycle.outcome = CollectOutcome::FetchFailed;
+                metrics.failureCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
             }
-            
-            const auto& stackInfos = stackInfosOpt.value();
-            
-            // 2. 转换为领域对象
-            std::vector<domain::Stack> stacks;
-            for (const auto& stackInfo : stackInfos) {
-                domain::Stack stack = ConvertToStack(stackInfo);
-                stacks.push_back(stack);
+            RecordBytes(metrics, fetched.value(), cycle);
+
+            // 与上次写入的相同则跳过解析和写入
+            uint64_t bodyHash = 0;
+            if (!force && IsUnchanged(metrics, m_stackInfoPayload, fetched.value(), bodyHash, cycle)) {
+                return true;
+            }
+            if (force) {
+                bodyHash = HashBody(fetched->body);
+            }
+
+            // 2. 流式解析，直接构建领域对象（不经过JSON DOM和StackInfoData）
+            auto stacks = StackInfoSaxParser::Parse(fetched->body);
+            phaseStart = RecordPhase(metrics.parseLatency, metrics.lastParseUs, cycle.parseUs, phaseStart);
+            if (!stacks.has_value()) {
+                cycle.outcome = CollectOutcome::ParseFailed;
+                metrics.failureCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            // 3. 与上次写入的比较，统计新增/消失/状态变化的业务链路
+            std::unordered_map<std::string, uint64_t> fingerprints;
+            fingerprints.reserve(stacks->size());
+            uint32_t changedStacks = 0;
+            size_t serviceCount = 0;
+            size_t taskCount = 0;
+            for (const auto& stack : stacks.value()) {
+                uint64_t fingerprint = StackFingerprint(stack);
+                auto it = m_stackFingerprints.find(stack.GetStackUUID());
+                if (it == m_stackFingerprints.end() || it->second != fingerprint) {
+                    changedStacks++;
+                }
+                fingerprints[stack.GetStackUUID()] = fingerprint;
+                serviceCount += stack.GetServiceCount();
+                taskCount += stack.GetTotalTaskCount();
             }
+            for (const auto& [stackUUID, fingerprint] : m_stackFingerprints) {
+                if (fingerprints.find(stackUUID) == fingerprints.end()) {
+                    changedStacks++;
+                }
+            }
+            phaseStart = RecordPhase(metrics.convertLatency, metrics.lastConvertUs, cycle.convertUs, phaseStart);
             
-            // 3. 批量保存
-            m_stackRepo->SaveAll(stacks);
+            // 4. 批量保存
+            m_stackRepo->SaveAll(stacks.value());
+
+            RecordPhase(metrics.commitLatency, metrics.lastCommitUs, cycle.commitUs, phaseStart);
+            CommitPayload(m_stackInfoPayload, bodyHash, std::move(fetched->etag));
+            m_stackFingerprints = std::move(fingerprints);
+            cycle.outcome = CollectOutcome::Applied;
+            cycle.changedEntities = changedStacks;
+            m_stackCount = static_cast<uint32_t>(stacks->size());
+            m_serviceCount = static_cast<uint32_t>(serviceCount);
+            m_taskCount = static_cast<uint32_t>(taskCount);
+            metrics.successCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
         } catch (const std::exception& e) {
+            cycle.outcome = CollectOutcome::Exception;
+            metrics.failureCount.fetch_add(1, std::memory_order_relaxed);
             std::cerr << "CollectStackInfo: 异常 - " << e.what() << std::endl;
+            return false;
         } catch (...) {
+            cycle.outcome = CollectOutcome::Exception;
+            metrics.failureCount.fetch_add(1, std::memory_order_relaxed);
             std::cerr << "CollectStackInfo: 未知异常" << std::endl;
+            return false;
         }
     }
 
@@ -256,112 +814,30 @@ class DataCollectorService {
         return result;
     }
 
-    /**
-     * @brief 转换StackInfo为Stack聚合根
-     */
-    domain::Stack ConvertToStack(const StackInfoData& stackInfo) const {
-        domain::Stack stack(stackInfo.stackUUID, stackInfo.stackName);
-        
-        // 设置状态
-        stack.SetDeployStatus(static_cast<domain::StackDeployStatus>(stackInfo.stackDeployStatus));
-        stack.SetRunningStatus(static_cast<domain::StackRunningStatus>(stackInfo.stackRunningStatus));
-        
-        // 添加标签
-        AddLabelsToStack(stack, stackInfo.stackLabelInfos);
-        
-        // 添加组件
-        AddServicesToStack(stack, stackInfo.serviceInfos);
-        
-        return stack;
-    }
-    
-    /**
-     * @brief 添加标签到Stack
-     */
-    void AddLabelsToStack(domain::Stack& stack, const std::vector<StackInfoData::LabelInfo>& labels) const {
-        for (const auto& labelInfo : labels) {
-            domain::StackLabelInfo label;
-            label.SetLabelName(labelInfo.labelName.c_str());
-            label.SetLabelUUID(labelInfo.labelUUID.c_str());
-            stack.AddLabel(label);
-        }
-    }
-    
-    /**
-     * @brief 添加组件到Stack
-     */
-    void AddServicesToStack(domain::Stack& stack, const std::vector<StackInfoData::ServiceInfo>& services) const {
-        for (const auto& serviceInfo : services) {
-            domain::Service service(serviceInfo.serviceUUID, serviceInfo.serviceName);
-            service.SetStatus(static_cast<domain::ServiceStatus>(serviceInfo.serviceStatus));
-            service.SetType(static_cast<domain::ServiceType>(serviceInfo.serviceType));
-            
-            // 添加任务
-            AddTasksToService(service, serviceInfo.taskInfos);
-            
-            stack.AddOrUpdateService(service);
-        }
-    }
-    
-    /**
-     * @brief 添加任务到Service
-     */
-    void AddTasksToService(domain::Service& service, const std::vector<StackInfoData::ServiceInfo::TaskInfo>& tasks) const {
-        for (const auto& taskInfo : tasks) {
-            domain::Task task(taskInfo.taskID);
-            task.SetTaskStatus(taskInfo.taskStatus);
-            task.SetBoardAddress(taskInfo.boardAddress);
-            
-            // 设置资源使用
-            domain::ResourceUsage resources = ConvertToResourceUsage(taskInfo);
-            task.UpdateResources(resources);
-            
-            // 设置位置信息
-            domain::LocationInfo location = ConvertToLocationInfo(taskInfo);
-            task.UpdateLocation(location);
-            
-            service.AddOrUpdateTask(task);
-        }
-    }
-    
-    /**
-     * @brief 转换TaskInfo的资源使用信息
-     */
-    domain::ResourceUsage ConvertToResourceUsage(const StackInfoData::ServiceInfo::TaskInfo& taskInfo) const {
-        domain::ResourceUsage resources;
-        resources.cpuCores = taskInfo.cpuCores;
-        resources.cpuUsed = taskInfo.cpuUsed;
-        resources.cpuUsage = taskInfo.cpuUsage;
-        resources.memorySize = taskInfo.memorySize;
-        resources.memoryUsed = taskInfo.memoryUsed;
-        resources.memoryUsage = taskInfo.memoryUsage;
-        resources.netReceive = taskInfo.netReceive;
-        resources.netSent = taskInfo.netSent;
-        resources.gpuMemUsed = taskInfo.gpuMemUsed;
-        return resources;
-    }
-    
-    /**
-     * @brief 转换TaskInfo的位置信息
-     */
-    domain::LocationInfo ConvertToLocationInfo(const StackInfoData::ServiceInfo::TaskInfo& taskInfo) const {
-        domain::LocationInfo location;
-        location.SetChassisName(taskInfo.chassisName.c_str());
-        location.chassisNumber = taskInfo.chassisNumber;
-        location.SetBoardName(taskInfo.boardName.c_str());
-        location.boardNumber = taskInfo.boardNumber;
-        location.SetBoardAddress(taskInfo.boardAddress.c_str());
-        return location;
-    }
-
 private:
     std::shared_ptr<QywApiClient> m_apiClient;
     std::shared_ptr<domain::IChassisRepository> m_chassisRepo;
     std::shared_ptr<domain::IStackRepository> m_stackRepo;
     
-    int m_intervalSeconds;          // 采集间隔
     std::atomic<bool> m_running;    // 运行标志
     std::thread m_thread;           // 后台线程
+    CollectScheduler m_scheduler;   // 采集调度（正常/快速轮询/失败退避）
+
+    EndpointMetrics m_boardInfoMetrics;             // boardinfo耗时统计
+    EndpointMetrics m_stackInfoMetrics;             // stackinfo耗时统计
+    PayloadState m_boardInfoPayload;                // boardinfo上次写入的响应
+    PayloadState m_stackInfoPayload;                // stackinfo上次写入的响应
+    std::atomic<uint64_t> m_lastCycleUs{0};         // 最近一个采集周期的耗时
+    std::shared_ptr<CollectCycleHistory> m_cycleHistory = std::make_shared<CollectCycleHistory>();  // 最近N个周期的记录
+    std::unordered_map<std::string, uint64_t> m_stackFingerprints;  // 上次写入的业务链路状态指纹（stackinfo采集线程访问）
+    uint32_t m_boardCount = 0;                      // 上次写入的数量（各接口的采集线程写入，周期结束后读取）
+    uint32_t m_stackCount = 0;
+    uint32_t m_serviceCount = 0;
+    uint32_t m_taskCount = 0;
+    std::atomic<uint32_t> m_pendingRefresh{0};      // 等待即时刷新的接口（EndpointBit按位或）
+    std::atomic<uint64_t> m_refreshRequests{0};     // 即时刷新请求次数
+    std::mutex m_presenceMutex;                     // 保护m_pendingPresence
+    std::unordered_map<std::string, bool> m_pendingPresence;  // 等待写入的板卡上下线（板卡地址 -> 是否在线）
 };
 
 } // namespace zygl::infrastructure
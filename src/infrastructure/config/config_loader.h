@@ -16,11 +16,22 @@ struct SystemConfig {
     struct {
         std::string apiUrl = "http://localhost:8080";
         int timeoutSeconds = 10;
+        int deployTimeoutSeconds = 0;       // 部署/卸载超时（秒，0表示与timeoutSeconds相同）
+        int maxConnections = 4;             // 到后端的最大并发连接数（keep-alive连接池大小）
+        int coalesceWindowMs = 20;          // 部署/卸载请求合并窗口（毫秒，0表示不合并）
+        int callSloMs = 1000;               // 后端调用SLO阈值（毫秒，超过时输出日志，0表示不检查）
+        std::string capturePath;            // 响应抓取文件路径前缀（为空表示不抓取，用于离线回放）
+        int captureSegmentMb = 64;          // 每个抓取分段文件的大小（MB）
     } backend;
     
     // 数据采集配置
     struct {
         int intervalSeconds = 5;
+        int fastPollIntervalMs = 1000;      // 快速轮询间隔（毫秒，部署/卸载之后）
+        int fastPollDurationSeconds = 30;   // 快速轮询时长（秒，0表示禁用快速轮询）
+        int maxBackoffSeconds = 60;         // 采集失败时指数退避的上限（秒）
+        int refreshMinIntervalMs = 200;     // Webhook触发的两次即时刷新之间的最小间隔（毫秒，0表示不限制）
+        int cycleHistorySize = 120;         // 保存明细的最近采集周期数（用于各阶段耗时统计）
     } dataCollector;
     
     // UDP通信配置
@@ -29,6 +40,24 @@ struct SystemConfig {
         int stateBroadcastPort = 5000;
         int commandListenerPort = 5001;
         int broadcastIntervalMs = 1000;
+        int sendBufferBytes = 0;            // 发送socket的SO_SNDBUF（0表示系统默认）
+        bool compressPayloads = false;      // 告警/标签数据报zlib压缩（需ZLIB编译选项）
+        int pacingPacketsPerSecond = 0;     // 广播限速：每秒数据报数（0表示不限制）
+        int pacingBytesPerSecond = 0;       // 广播限速：每秒字节数（0表示不限制）
+        int receiveBufferBytes = 0;         // 命令socket的SO_RCVBUF（0表示系统默认）
+        int commandWorkers = 2;             // 部署/卸载命令执行线程数
+        int commandQueueCapacity = 64;      // 等待执行的命令数上限（超出时回复Busy）
+        int ackWorkers = 1;                 // 确认告警命令执行线程数（交互通道）
+        int ackQueueCapacity = 256;         // 等待执行的确认告警命令数上限（超出时回复Busy）
+        int commandDedupWindowMs = 30000;   // 重发命令去重窗口（毫秒，0表示禁用）
+        int commandListenerShards = 1;      // 命令接收分片数（SO_REUSEPORT，每个分片一个socket和线程）
+        int commandSloMs = 1000;            // 命令响应时间SLO阈值（毫秒，超过时输出日志，0表示不检查）
+        bool commandResponseAuditEcho = false;  // 命令最终结果是否同时多播回显（响应总是单播回复发送方）
+        std::string retransmitAllowedSubnet;    // 允许发送重传请求（NACK）的网段（如"192.168.1.0/24"，空表示不响应NACK）
+        int retransmitPacketsPerSecond = 200;   // 每个发送方每秒最多重传的数据报数（0表示不限制）
+        int retransmitBytesPerSecond = 2097152; // 每个发送方每秒最多重传的字节数（0表示不限制）
+        int retransmitTotalPacketsPerSecond = 1000;     // 所有发送方合计每秒最多重传的数据报数（0表示不限制）
+        int retransmitTotalBytesPerSecond = 8388608;    // 所有发送方合计每秒最多重传的字节数（0表示不限制）
     } udp;
     
     // Webhook配置
@@ -93,6 +122,24 @@ class ConfigLoader {
                 if (backend.contains("timeout_seconds")) {
                     config.backend.timeoutSeconds = backend["timeout_seconds"].get<int>();
                 }
+                if (backend.contains("deploy_timeout_seconds")) {
+                    config.backend.deployTimeoutSeconds = backend["deploy_timeout_seconds"].get<int>();
+                }
+                if (backend.contains("max_connections")) {
+                    config.backend.maxConnections = backend["max_connections"].get<int>();
+                }
+                if (backend.contains("coalesce_window_ms")) {
+                    config.backend.coalesceWindowMs = backend["coalesce_window_ms"].get<int>();
+                }
+                if (backend.contains("call_slo_ms")) {
+                    config.backend.callSloMs = backend["call_slo_ms"].get<int>();
+                }
+                if (backend.contains("capture_path")) {
+                    config.backend.capturePath = backend["capture_path"].get<std::string>();
+                }
+                if (backend.contains("capture_segment_mb")) {
+                    config.backend.captureSegmentMb = backend["capture_segment_mb"].get<int>();
+                }
             }
             
             // 读取数据采集配置
@@ -101,6 +148,21 @@ class ConfigLoader {
                 if (dc.contains("interval_seconds")) {
                     config.dataCollector.intervalSeconds = dc["interval_seconds"].get<int>();
                 }
+                if (dc.contains("fast_poll_interval_ms")) {
+                    config.dataCollector.fastPollIntervalMs = dc["fast_poll_interval_ms"].get<int>();
+                }
+                if (dc.contains("fast_poll_duration_seconds")) {
+                    config.dataCollector.fastPollDurationSeconds = dc["fast_poll_duration_seconds"].get<int>();
+                }
+                if (dc.contains("max_backoff_seconds")) {
+                    config.dataCollector.maxBackoffSeconds = dc["max_backoff_seconds"].get<int>();
+                }
+                if (dc.contains("refresh_min_interval_ms")) {
+                    config.dataCollector.refreshMinIntervalMs = dc["refresh_min_interval_ms"].get<int>();
+                }
+                if (dc.contains("cycle_history_size")) {
+                    config.dataCollector.cycleHistorySize = dc["cycle_history_size"].get<int>();
+                }
             }
             
             // 读取UDP配置
@@ -118,6 +180,60 @@ class ConfigLoader {
                 if (udp.contains("broadcast_interval_ms")) {
                     config.udp.broadcastIntervalMs = udp["broadcast_interval_ms"].get<int>();
                 }
+                if (udp.contains("send_buffer_bytes")) {
+                    config.udp.sendBufferBytes = udp["send_buffer_bytes"].get<int>();
+                }
+                if (udp.contains("compress_payloads")) {
+                    config.udp.compressPayloads = udp["compress_payloads"].get<bool>();
+                }
+                if (udp.contains("pacing_packets_per_second")) {
+                    config.udp.pacingPacketsPerSecond = udp["pacing_packets_per_second"].get<int>();
+                }
+                if (udp.contains("pacing_bytes_per_second")) {
+                    config.udp.pacingBytesPerSecond = udp["pacing_bytes_per_second"].get<int>();
+                }
+                if (udp.contains("receive_buffer_bytes")) {
+                    config.udp.receiveBufferBytes = udp["receive_buffer_bytes"].get<int>();
+                }
+                if (udp.contains("command_workers")) {
+                    config.udp.commandWorkers = udp["command_workers"].get<int>();
+                }
+                if (udp.contains("command_queue_capacity")) {
+                    config.udp.commandQueueCapacity = udp["command_queue_capacity"].get<int>();
+                }
+                if (udp.contains("ack_workers")) {
+                    config.udp.ackWorkers = udp["ack_workers"].get<int>();
+                }
+                if (udp.contains("ack_queue_capacity")) {
+                    config.udp.ackQueueCapacity = udp["ack_queue_capacity"].get<int>();
+                }
+                if (udp.contains("command_dedup_window_ms")) {
+                    config.udp.commandDedupWindowMs = udp["command_dedup_window_ms"].get<int>();
+                }
+                if (udp.contains("command_listener_shards")) {
+                    config.udp.commandListenerShards = udp["command_listener_shards"].get<int>();
+                }
+                if (udp.contains("command_slo_ms")) {
+                    config.udp.commandSloMs = udp["command_slo_ms"].get<int>();
+                }
+                if (udp.contains("command_response_audit_echo")) {
+                    config.udp.commandResponseAuditEcho = udp["command_response_audit_echo"].get<bool>();
+                }
+                if (udp.contains("retransmit_allowed_subnet")) {
+                    config.udp.retransmitAllowedSubnet = udp["retransmit_allowed_subnet"].get<std::string>();
+                }
+                if (udp.contains("retransmit_packets_per_second")) {
+                    config.udp.retransmitPacketsPerSecond = udp["retransmit_packets_per_second"].get<int>();
+                }
+                if (udp.contains("retransmit_bytes_per_second")) {
+                    config.udp.retransmitBytesPerSecond = udp["retransmit_bytes_per_second"].get<int>();
+                }
+                if (udp.contains("retransmit_total_packets_per_second")) {
+                    config.udp.retransmitTotalPacketsPerSecond = udp["retransmit_total_packets_per_second"].get<int>();
+                }
+                if (udp.contains("retransmit_total_bytes_per_second")) {
+                    config.udp.retransmitTotalBytesPerSecond = udp["retransmit_total_bytes_per_second"].get<int>();
+                }
             }
             
             // 读取Webhook配置
@@ -234,13 +350,43 @@ class ConfigLoader {
         std::cout << "  后端API:\n";
         std::cout << "    - 地址: " << config.backend.apiUrl << "\n";
         std::cout << "    - 超时: " << config.backend.timeoutSeconds << "秒\n";
+        std::cout << "    - 部署/卸载超时: " << config.backend.deployTimeoutSeconds << "秒（0表示同上）\n";
+        std::cout << "    - 最大连接数: " << config.backend.maxConnections << "\n";
+        std::cout << "    - 请求合并窗口: " << config.backend.coalesceWindowMs << "毫秒\n";
+        std::cout << "    - 调用SLO: " << config.backend.callSloMs << "毫秒\n";
+        std::cout << "    - 响应抓取: " << (config.backend.capturePath.empty() ? "关闭" : config.backend.capturePath)
+                  << "（分段" << config.backend.captureSegmentMb << "MB）\n";
         std::cout << "  数据采集:\n";
         std::cout << "    - 间隔: " << config.dataCollector.intervalSeconds << "秒\n";
+        std::cout << "    - 快速轮询: " << config.dataCollector.fastPollIntervalMs << "毫秒间隔, 持续"
+                  << config.dataCollector.fastPollDurationSeconds << "秒\n";
+        std::cout << "    - 失败退避上限: " << config.dataCollector.maxBackoffSeconds << "秒\n";
+        std::cout << "    - 即时刷新最小间隔: " << config.dataCollector.refreshMinIntervalMs << "毫秒\n";
+        std::cout << "    - 周期统计保存数: " << config.dataCollector.cycleHistorySize << "\n";
         std::cout << "  UDP通信:\n";
         std::cout << "    - 组播地址: " << config.udp.multicastAddress << "\n";
         std::cout << "    - 状态广播端口: " << config.udp.stateBroadcastPort << "\n";
         std::cout << "    - 命令监听端口: " << config.udp.commandListenerPort << "\n";
         std::cout << "    - 广播间隔: " << config.udp.broadcastIntervalMs << "ms\n";
+        std::cout << "    - 发送缓冲区: " << config.udp.sendBufferBytes << "字节\n";
+        std::cout << "    - 载荷压缩: " << (config.udp.compressPayloads ? "启用" : "禁用") << "\n";
+        std::cout << "    - 发送限速: " << config.udp.pacingPacketsPerSecond << "包/秒, "
+                  << config.udp.pacingBytesPerSecond << "字节/秒（0表示不限制）\n";
+        std::cout << "    - 接收缓冲区: " << config.udp.receiveBufferBytes << "字节\n";
+        std::cout << "    - 命令执行: " << config.udp.commandWorkers << "线程, 队列"
+                  << config.udp.commandQueueCapacity << "\n";
+        std::cout << "    - 确认告警执行: " << config.udp.ackWorkers << "线程, 队列"
+                  << config.udp.ackQueueCapacity << "\n";
+        std::cout << "    - 命令去重窗口: " << config.udp.commandDedupWindowMs << "毫秒\n";
+        std::cout << "    - 命令接收分片: " << config.udp.commandListenerShards << "\n";
+        std::cout << "    - 命令响应SLO: " << config.udp.commandSloMs << "毫秒\n";
+        std::cout << "    - 命令结果多播回显: " << (config.udp.commandResponseAuditEcho ? "开启" : "关闭") << "\n";
+        std::cout << "    - 重传请求网段: "
+                  << (config.udp.retransmitAllowedSubnet.empty() ? "未配置（不响应NACK）" : config.udp.retransmitAllowedSubnet)
+                  << ", 每发送方限速 " << config.udp.retransmitPacketsPerSecond << "包/秒, "
+                  << config.udp.retransmitBytesPerSecond << "字节/秒, 合计限速 "
+                  << config.udp.retransmitTotalPacketsPerSecond << "包/秒, "
+                  << config.udp.retransmitTotalBytesPerSecond << "字节/秒（0表示不限制）\n";
         std::cout << "  Webhook:\n";
         std::cout << "    - 监听端口: " << config.webhook.listenPort << "\n";
         std::cout << "  硬件拓扑:\n";
@@ -17,7 +17,9 @@
 #include "persistence/in_memory_alert_repository.h"
 
 // API客户端
+#include "api_client/http_client_pool.h"
 #include "api_client/qyw_api_client.h"
+#include "api_client/stack_info_sax_parser.h"
 
 // 配置和工厂
 #include "config/chassis_factory.h"
@@ -25,6 +27,9 @@
 // 数据采集器
 #include "collectors/data_collector_service.h"
 
+// 运行指标
+#include "metrics/latency_histogram.h"
+
 namespace zygl::infrastructure {
 
 /**
@@ -87,11 +92,13 @@ class ServiceFactory {
      * @brief 创建API客户端
      * @param baseUrl API基础URL
      * @param timeout 超时时间（秒）
+     * @param maxConnections 到后端的最大并发连接数
      */
     static std::shared_ptr<QywApiClient> CreateApiClient(
         const std::string& baseUrl, 
-        int timeout = 10) {
-        return std::make_shared<QywApiClient>(baseUrl, timeout);
+        int timeout = 10,
+        size_t maxConnections = QywApiClient::DEFAULT_MAX_CONNECTIONS) {
+        return std::make_shared<QywApiClient>(baseUrl, timeout, maxConnections);
     }
 
     /**
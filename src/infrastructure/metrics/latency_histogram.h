@@ -0,0 +1,259 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace zygl::infrastructure {
+
+/**
+ * @brief 延迟分布摘要（单位：微秒）
+ */
+struct LatencySummary {
+    uint64_t count = 0;             // 样本数
+    uint64_t meanUs = 0;            // 平均值
+    uint64_t p50Us = 0;             // 中位数
+    uint64_t p90Us = 0;             // 90分位
+    uint64_t p99Us = 0;             // 99分位
+    uint64_t p999Us = 0;            // 99.9分位
+    uint64_t maxUs = 0;             // 最大值
+};
+
+/**
+ * @brief LatencyHistogram - 无锁延迟直方图（HDR风格对数-线性分桶）
+ *
+ * 以微秒记录延迟。每个2的幂区间再线性划分为16个子桶，相对误差不超过1/16（约6%），
+ * 覆盖1微秒到约12天，共608个桶，内存固定（约5KB）。
+ *
+ * Record()只做几次relaxed原子加法（最大值用CAS），不加锁、不分配内存，
+ * 可以在接收线程/执行线程的热路径上调用。
+ * 分位数读取的是各桶计数的近似快照（与并发写入之间不保证严格一致），用于观测足够。
+ *
+ * 线程安全：
+ * - 所有方法都可以被任意线程并发调用
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 4;                          // 每个2的幂区间16个子桶
+    static constexpr uint64_t SUB_BUCKET_COUNT = 1ULL << SUB_BUCKET_BITS;
+    static constexpr unsigned MAX_VALUE_BITS = 40;                          // 最大记录值2^40微秒
+    static constexpr uint64_t MAX_VALUE_US = (1ULL << MAX_VALUE_BITS) - 1;
+    static constexpr size_t BUCKET_COUNT =
+        (MAX_VALUE_BITS - SUB_BUCKET_BITS + 2) * SUB_BUCKET_COUNT;
+
+    LatencyHistogram() {
+        for (auto& bucket : m_buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // 禁止拷贝
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief 记录一个延迟样本（微秒，超出范围时截断到最大值）
+     */
+    void Record(uint64_t micros) {
+        micros = std::min(micros, MAX_VALUE_US);
+        m_buckets[BucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(micros, std::memory_order_relaxed);
+
+        uint64_t currentMax = m_max.load(std::memory_order_relaxed);
+        while (micros > currentMax &&
+               !m_max.compare_exchange_weak(currentMax, micros, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief 记录一个延迟样本
+     */
+    template<typename Rep, typename Period>
+    void Record(std::chrono::duration<Rep, Period> latency) {
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+        Record(static_cast<uint64_t>(std::max<decltype(micros)>(micros, 0)));
+    }
+
+    /**
+     * @brief 获取样本数
+     */
+    uint64_t GetCount() const {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 计算分位数（返回所在桶的上界，不超过记录到的最大值）
+     *
+     * @param quantile 0.0 ~ 1.0
+     * @return 延迟（微秒），无样本时返回0
+     */
+    uint64_t ValueAtQuantile(double quantile) const {
+        std::array<uint64_t, BUCKET_COUNT> counts;
+        uint64_t total = LoadCounts(counts);
+        return ValueAtQuantile(counts, total, quantile);
+    }
+
+    /**
+     * @brief 获取分布摘要（一次快照计算所有分位数）
+     */
+    LatencySummary GetSummary() const {
+        std::array<uint64_t, BUCKET_COUNT> counts;
+        uint64_t total = LoadCounts(counts);
+
+        LatencySummary summary;
+        summary.count = total;
+        if (total == 0) {
+            return summary;
+        }
+        uint64_t sampleCount = std::max<uint64_t>(m_count.load(std::memory_order_relaxed), 1);
+        summary.meanUs = m_sum.load(std::memory_order_relaxed) / sampleCount;
+        summary.p50Us = ValueAtQuantile(counts, total, 0.50);
+        summary.p90Us = ValueAtQuantile(counts, total, 0.90);
+        summary.p99Us = ValueAtQuantile(counts, total, 0.99);
+        summary.p999Us = ValueAtQuantile(counts, total, 0.999);
+        summary.maxUs = m_max.load(std::memory_order_relaxed);
+        return summary;
+    }
+
+private:
+    /**
+     * @brief 计算值所在的桶：小于16的值每个值一个桶，之后每个2的幂区间16个桶
+     */
+    static size_t BucketIndex(uint64_t value) {
+        if (value < SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(value);
+        }
+        unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(value));
+        unsigned shift = msb - SUB_BUCKET_BITS;
+        return static_cast<size_t>((shift + 1) * SUB_BUCKET_COUNT + (value >> shift) - SUB_BUCKET_COUNT);
+    }
+
+    /**
+     * @brief 桶的上界（包含）
+     */
+    static uint64_t BucketUpperBound(size_t index) {
+        if (index < SUB_BUCKET_COUNT) {
+            return index;
+        }
+        unsigned shift = static_cast<unsigned>(index / SUB_BUCKET_COUNT) - 1;
+        uint64_t mantissa = index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+    uint64_t LoadCounts(std::array<uint64_t, BUCKET_COUNT>& counts) const {
+        uint64_t total = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+        return total;
+    }
+
+    uint64_t ValueAtQuantile(const std::array<uint64_t, BUCKET_COUNT>& counts,
+                             uint64_t total, double quantile) const {
+        if (total == 0) {
+            return 0;
+        }
+        quantile = std::min(std::max(quantile, 0.0), 1.0);
+        uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(quantile * static_cast<double>(total) + 0.5), 1);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return std::min(BucketUpperBound(i), m_max.load(std::memory_order_relaxed));
+            }
+        }
+        return m_max.load(std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_buckets;
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_max{0};
+};
+
+/**
+ * @brief SloMonitor - 响应时间SLO检查
+ *
+ * 延迟超过阈值时输出告警日志。日志限频为每秒最多一条，
+ * 期间被抑制的超标次数在下一条日志中一并报告；超标总数始终计数。
+ *
+ * 线程安全：
+ * - 所有方法都可以被任意线程并发调用
+ */
+class SloMonitor {
+public:
+    /**
+     * @brief 构造函数
+     *
+     * @param name 日志中的名称（如"CommandListener"）
+     */
+    explicit SloMonitor(std::string name)
+        : m_name(std::move(name)) {
+    }
+
+    /**
+     * @brief 设置阈值（0表示不检查）
+     */
+    void SetThreshold(std::chrono::milliseconds threshold) {
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(threshold).count();
+        m_thresholdUs.store(micros > 0 ? static_cast<uint64_t>(micros) : 0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 检查一次操作的延迟
+     *
+     * @param operation 操作名称（如"DeployStack"）
+     * @param micros 延迟（微秒）
+     * @return true 如果超过阈值
+     */
+    bool Check(const char* operation, uint64_t micros) {
+        uint64_t threshold = m_thresholdUs.load(std::memory_order_relaxed);
+        if (threshold == 0 || micros <= threshold) {
+            return false;
+        }
+        m_breaches.fetch_add(1, std::memory_order_relaxed);
+
+        int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t lastLog = m_lastLogMs.load(std::memory_order_relaxed);
+        if (now - lastLog < LOG_INTERVAL_MS ||
+            !m_lastLogMs.compare_exchange_strong(lastLog, now, std::memory_order_relaxed)) {
+            m_suppressed.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        uint64_t suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+        std::cerr << m_name << ": " << operation << " 耗时" << micros / 1000 << "ms，超过SLO阈值"
+                  << threshold / 1000 << "ms";
+        if (suppressed > 0) {
+            std::cerr << "（此前另有" << suppressed << "次超标未记录）";
+        }
+        std::cerr << std::endl;
+        return true;
+    }
+
+    /**
+     * @brief 获取超标总次数
+     */
+    uint64_t GetBreachCount() const {
+        return m_breaches.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr int64_t LOG_INTERVAL_MS = 1000;    // 日志限频间隔
+
+    std::string m_name;
+    std::atomic<uint64_t> m_thresholdUs{0};
+    std::atomic<int64_t> m_lastLogMs{INT64_MIN / 2};
+    std::atomic<uint64_t> m_breaches{0};
+    std::atomic<uint64_t> m_suppressed{0};
+};
+
+} // namespace zygl::infrastructure
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../../domain/repository_change_listener.h"
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+
+namespace zygl::infrastructure {
+
+/**
+ * @brief ChangeNotifier - 仓储变更通知器
+ * 
+ * 保存已注册的RepositoryChangeListener，由内存仓储在写操作完成后调用Notify()。
+ * 
+ * 线程安全：
+ * - Add()使用独占锁，Notify()使用共享锁，可以被多个写入线程并发调用
+ */
+class ChangeNotifier {
+public:
+    /**
+     * @brief 注册监听器
+     */
+    void Add(domain::RepositoryChangeListener listener) {
+        if (!listener) {
+            return;
+        }
+        std::unique_lock lock(m_mutex);
+        m_listeners.push_back(std::move(listener));
+    }
+
+    /**
+     * @brief 通知所有监听器（应在释放仓储写锁之后调用）
+     */
+    void Notify() const {
+        std::shared_lock lock(m_mutex);
+        for (const auto& listener : m_listeners) {
+            listener();
+        }
+    }
+
+private:
+    std::vector<domain::RepositoryChangeListener> m_listeners;
+    mutable std::shared_mutex m_mutex;
+};
+
+} // namespace zygl::infrastructure
@@ -2,10 +2,12 @@
 
 #include "../../domain/i_alert_repository.h"
 #include "../../domain/alert.h"
+#include "change_notifier.h"
 #include <map>
 #include <vector>
 #include <optional>
 #include <shared_mutex>
+#include <atomic>
 #include <string>
 #include <algorithm>
 
@@ -36,9 +38,13 @@ class InMemoryAlertRepository : public domain::IAlertRepository {
      * @brief 保存一个告警
      */
     void Save(const domain::Alert& alert) override {
-        std::unique_lock lock(m_mutex);  // 写锁
-        std::string uuid(alert.GetAlertUUID());
-        m_alerts[uuid] = alert;
+        {
+            std::unique_lock lock(m_mutex);  // 写锁
+            std::string uuid(alert.GetAlertUUID());
+            m_alerts[uuid] = alert;
+        }
+        m_version.fetch_add(1, std::memory_order_acq_rel);
+        m_notifier.Notify();
     }
 
     /**
@@ -164,32 +170,49 @@ class InMemoryAlertRepository : public domain::IAlertRepository {
      * @brief 确认一个告警
      */
     bool Acknowledge(const std::string& alertUUID) override {
-        std::unique_lock lock(m_mutex);  // 写锁
-        
-        auto it = m_alerts.find(alertUUID);
-        if (it != m_alerts.end()) {
+        {
+            std::unique_lock lock(m_mutex);  // 写锁
+            
+            auto it = m_alerts.find(alertUUID);
+            if (it == m_alerts.end()) {
+                return false;
+            }
             it->second.Acknowledge();
-            return true;
         }
         
-        return false;
+        m_version.fetch_add(1, std::memory_order_acq_rel);
+        m_notifier.Notify();
+        return true;
     }
 
     /**
      * @brief 批量确认多个告警
      */
-    size_t AcknowledgeMultiple(const std::vector<std::string>& alertUUIDs) override {
-        std::unique_lock lock(m_mutex);  // 写锁
-        
+    size_t AcknowledgeMultiple(const std::vector<std::string>& alertUUIDs,
+                               std::vector<bool>* acknowledged = nullptr) override {
         size_t count = 0;
-        for (const auto& uuid : alertUUIDs) {
-            auto it = m_alerts.find(uuid);
-            if (it != m_alerts.end()) {
-                it->second.Acknowledge();
-                count++;
+        if (acknowledged) {
+            acknowledged->assign(alertUUIDs.size(), false);
+        }
+        {
+            std::unique_lock lock(m_mutex);  // 写锁
+            
+            for (size_t i = 0; i < alertUUIDs.size(); ++i) {
+                auto it = m_alerts.find(alertUUIDs[i]);
+                if (it != m_alerts.end()) {
+                    it->second.Acknowledge();
+                    count++;
+                    if (acknowledged) {
+                        (*acknowledged)[i] = true;
+                    }
+                }
             }
         }
         
+        if (count > 0) {
+            m_version.fetch_add(1, std::memory_order_acq_rel);
+            m_notifier.Notify();
+        }
         return count;
     }
 
@@ -197,8 +220,17 @@ class InMemoryAlertRepository : public domain::IAlertRepository {
      * @brief 移除一个告警
      */
     bool Remove(const std::string& alertUUID) override {
-        std::unique_lock lock(m_mutex);  // 写锁
-        return m_alerts.erase(alertUUID) > 0;
+        bool removed = false;
+        {
+            std::unique_lock lock(m_mutex);  // 写锁
+            removed = m_alerts.erase(alertUUID) > 0;
+        }
+        
+        if (removed) {
+            m_version.fetch_add(1, std::memory_order_acq_rel);
+            m_notifier.Notify();
+        }
+        return removed;
     }
 
     /**
@@ -210,23 +242,28 @@ class InMemoryAlertRepository : public domain::IAlertRepository {
      * @return 删除的告警数量
      */
     size_t RemoveExpired(uint64_t maxAgeSeconds) override {
-        std::unique_lock lock(m_mutex);  // 写锁
-        
         size_t removedCount = 0;
-        auto it = m_alerts.begin();
-        
-        while (it != m_alerts.end()) {
-            const auto& alert = it->second;
+        {
+            std::unique_lock lock(m_mutex);  // 写锁
             
-            // 只删除已确认且超过保留时间的告警
-            if (alert.IsAcknowledged() && alert.GetAgeInSeconds() > maxAgeSeconds) {
-                it = m_alerts.erase(it);
-                removedCount++;
-            } else {
-                ++it;
+            auto it = m_alerts.begin();
+            while (it != m_alerts.end()) {
+                const auto& alert = it->second;
+                
+                // 只删除已确认且超过保留时间的告警
+                if (alert.IsAcknowledged() && alert.GetAgeInSeconds() > maxAgeSeconds) {
+                    it = m_alerts.erase(it);
+                    removedCount++;
+                } else {
+                    ++it;
+                }
             }
         }
         
+        if (removedCount > 0) {
+            m_version.fetch_add(1, std::memory_order_acq_rel);
+            m_notifier.Notify();
+        }
         return removedCount;
     }
 
@@ -234,8 +271,12 @@ class InMemoryAlertRepository : public domain::IAlertRepository {
      * @brief 清空所有告警
      */
     void Clear() override {
-        std::unique_lock lock(m_mutex);  // 写锁
-        m_alerts.clear();
+        {
+            std::unique_lock lock(m_mutex);  // 写锁
+            m_alerts.clear();
+        }
+        m_version.fetch_add(1, std::memory_order_acq_rel);
+        m_notifier.Notify();
     }
 
     /**
@@ -294,12 +335,30 @@ class InMemoryAlertRepository : public domain::IAlertRepository {
         return count;
     }
 
+    /**
+     * @brief 注册变更监听器（写操作释放写锁后调用）
+     */
+    void AddChangeListener(domain::RepositoryChangeListener listener) override {
+        m_notifier.Add(std::move(listener));
+    }
+
+    /**
+     * @brief 获取当前数据版本号（无锁）
+     */
+    uint64_t GetVersion() const override {
+        return m_version.load(std::memory_order_acquire);
+    }
+
 private:
     // 存储：Key = alertUUID, Value = Alert聚合根
     std::map<std::string, domain::Alert> m_alerts;
     
     // 读写锁（C++17）
     mutable std::shared_mutex m_mutex;
+    
+    // 变更通知
+    ChangeNotifier m_notifier;
+    std::atomic<uint64_t> m_version{0};     // 数据版本号（每次写操作后递增）
 };
 
 } // namespace zygl::infrastructure
@@ -2,6 +2,7 @@
 
 #include "../../domain/i_chassis_repository.h"
 #include "../../domain/chassis.h"
+#include "change_notifier.h"
 #include <array>
 #include <atomic>
 #include <memory>
@@ -74,17 +75,25 @@ class InMemoryChassisRepository : public domain::IChassisRepository {
      * @param allChassis 所有9个机箱的新状态
      */
     void SaveAll(const std::array<domain::Chassis, domain::TOTAL_CHASSIS_COUNT>& allChassis) override {
-        // 使用互斥锁保护写操作，防止多个写入者同时修改
-        std::lock_guard<std::mutex> lock(m_writeMutex);
-        
-        // 步骤1：将新数据写入后台缓冲
-        *m_backBuffer = allChassis;
-        
-        // 步骤2：原子交换缓冲指针
-        auto* oldActive = m_activeBuffer.exchange(m_backBuffer, std::memory_order_acq_rel);
+        {
+            // 使用互斥锁保护写操作，防止多个写入者同时修改
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            
+            // 步骤1：将新数据写入后台缓冲
+            *m_backBuffer = allChassis;
+            
+            // 步骤2：原子交换缓冲指针
+            auto* oldActive = m_activeBuffer.exchange(m_backBuffer, std::memory_order_acq_rel);
+            
+            // 步骤3：更新后台缓冲指针（之前的活动缓冲变成新的后台缓冲）
+            m_backBuffer = oldActive;
+            
+            // 交换之后再递增版本号：读到新版本号的读取者一定能看到新数据
+            m_version.fetch_add(1, std::memory_order_acq_rel);
+        }
         
-        // 步骤3：更新后台缓冲指针（之前的活动缓冲变成新的后台缓冲）
-        m_backBuffer = oldActive;
+        // 步骤4：通知监听器（如状态广播器立即推送）
+        m_notifier.Notify();
     }
 
     /**
@@ -228,15 +237,33 @@ class InMemoryChassisRepository : public domain::IChassisRepository {
      * @param initialChassis 初始的9个机箱（由ChassisFactory创建）
      */
     void Initialize(const std::array<domain::Chassis, domain::TOTAL_CHASSIS_COUNT>& initialChassis) override {
-        std::lock_guard<std::mutex> lock(m_writeMutex);
-        
-        // 初始化两个缓冲
-        m_buffer_A = initialChassis;
-        m_buffer_B = initialChassis;
-        
-        // 确保活动缓冲指向buffer_A
-        m_activeBuffer.store(&m_buffer_A, std::memory_order_release);
-        m_backBuffer = &m_buffer_B;
+        {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            
+            // 初始化两个缓冲
+            m_buffer_A = initialChassis;
+            m_buffer_B = initialChassis;
+            
+            // 确保活动缓冲指向buffer_A
+            m_activeBuffer.store(&m_buffer_A, std::memory_order_release);
+            m_backBuffer = &m_buffer_B;
+            m_version.fetch_add(1, std::memory_order_acq_rel);
+        }
+        m_notifier.Notify();
+    }
+
+    /**
+     * @brief 注册变更监听器（SaveAll/Initialize交换缓冲后调用）
+     */
+    void AddChangeListener(domain::RepositoryChangeListener listener) override {
+        m_notifier.Add(std::move(listener));
+    }
+
+    /**
+     * @brief 获取当前快照版本号（无锁）
+     */
+    uint64_t GetVersion() const override {
+        return m_version.load(std::memory_order_acquire);
     }
 
 private:
@@ -254,6 +281,12 @@ class InMemoryChassisRepository : public domain::IChassisRepository {
     
     // 写操作互斥锁（保护 SaveAll 和 Initialize）
     mutable std::mutex m_writeMutex;
+    
+    // 快照版本号（每次交换缓冲后递增）
+    std::atomic<uint64_t> m_version{0};
+    
+    // 变更通知
+    ChangeNotifier m_notifier;
 };
 
 } // namespace zygl::infrastructure
@@ -2,12 +2,19 @@
 
 #include "../../domain/i_stack_repository.h"
 #include "../../domain/stack.h"
+#include "change_notifier.h"
 #include <map>
 #include <vector>
 #include <optional>
 #include <mutex>
 #include <shared_mutex>
+#include <atomic>
 #include <string>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <array>
+#include <memory>
 
 namespace zygl::infrastructure {
 
@@ -18,6 +25,8 @@ namespace zygl::infrastructure {
  * 1. 使用std::map存储Stack聚合根（Key: stackUUID）
  * 2. 使用std::shared_mutex实现读写锁
  * 3. 多个读取者可以并发读取，写入者独占访问
+ * 4. 维护位置索引（机箱/板卡/任务序号 -> 任务），每次写操作后重新解析，
+ *    FindTaskAt()为常数时间且不分配内存
  * 
  * 线程安全：
  * - 读取操作使用std::shared_lock（共享锁）
@@ -26,7 +35,9 @@ namespace zygl::infrastructure {
  */
 class InMemoryStackRepository : public domain::IStackRepository {
 public:
-    InMemoryStackRepository() = default;
+    InMemoryStackRepository()
+        : m_taskSlots(std::make_unique<TaskSlotTable>()) {
+    }
     
     // 禁止拷贝和移动
     InMemoryStackRepository(const InMemoryStackRepository&) = delete;
@@ -38,8 +49,13 @@ class InMemoryStackRepository : public domain::IStackRepository {
      * 如果UUID已存在则更新，否则插入。
      */
     void Save(const domain::Stack& stack) override {
-        std::unique_lock lock(m_mutex);  // 写锁
-        m_stacks[stack.GetStackUUID()] = stack;
+        {
+            std::unique_lock lock(m_mutex);  // 写锁
+            m_stacks[stack.GetStackUUID()] = stack;
+            ResolveTaskSlots();
+        }
+        m_version.fetch_add(1, std::memory_order_acq_rel);
+        m_notifier.Notify();
     }
 
     /**
@@ -48,11 +64,16 @@ class InMemoryStackRepository : public domain::IStackRepository {
      * 用于DataCollector从API拉取数据后批量更新。
      */
     void SaveAll(const std::vector<domain::Stack>& stacks) override {
-        std::unique_lock lock(m_mutex);  // 写锁
-        
-        for (const auto& stack : stacks) {
-            m_stacks[stack.GetStackUUID()] = stack;
+        {
+            std::unique_lock lock(m_mutex);  // 写锁
+            
+            for (const auto& stack : stacks) {
+                m_stacks[stack.GetStackUUID()] = stack;
+            }
+            ResolveTaskSlots();
         }
+        m_version.fetch_add(1, std::memory_order_acq_rel);
+        m_notifier.Notify();
     }
 
     /**
@@ -139,20 +160,108 @@ class InMemoryStackRepository : public domain::IStackRepository {
         return std::nullopt;
     }
 
+    /**
+     * @brief 更新任务的物理位置（由DataCollector在提交boardinfo后调用）
+     * 
+     * 重建位置索引。不通知变更监听器（业务链路本身未变化）。
+     */
+    void UpdateTaskPlacement(
+        const std::array<domain::Chassis, domain::TOTAL_CHASSIS_COUNT>& allChassis) override {
+        std::unique_lock lock(m_mutex);  // 写锁
+        
+        for (auto& chassisSlots : *m_taskSlots) {
+            for (auto& boardSlots : chassisSlots) {
+                for (auto& slot : boardSlots) {
+                    slot = TaskSlot();
+                }
+            }
+        }
+        
+        for (const auto& chassis : allChassis) {
+            int32_t chassisIndex = chassis.GetChassisNumber() - 1;
+            if (chassisIndex < 0 || chassisIndex >= domain::TOTAL_CHASSIS_COUNT) {
+                continue;  // 跳过未初始化的机箱
+            }
+            
+            for (const auto& board : chassis.GetAllBoards()) {
+                int32_t boardIndex = board.GetBoardNumber() - 1;
+                if (boardIndex < 0 || boardIndex >= domain::BOARDS_PER_CHASSIS) {
+                    continue;
+                }
+                
+                const auto& tasks = board.GetTasks();
+                for (int32_t i = 0; i < board.GetTaskCount() && i < domain::MAX_TASKS_PER_BOARD; ++i) {
+                    auto& slot = (*m_taskSlots)[chassisIndex][boardIndex][i];
+                    CopyString(slot.taskID, sizeof(slot.taskID), tasks[i].taskID);
+                    CopyString(slot.taskStatus, sizeof(slot.taskStatus), tasks[i].taskStatus);
+                    CopyString(slot.boardAddress, sizeof(slot.boardAddress), board.GetBoardAddress());
+                }
+            }
+        }
+        
+        ResolveTaskSlots();
+    }
+
+    /**
+     * @brief 按位置查找任务（常数时间，不分配内存）
+     */
+    std::optional<domain::TaskSlotView> FindTaskAt(
+        int32_t chassisNumber, int32_t boardNumber, int32_t taskIndex) const override {
+        if (chassisNumber < 1 || chassisNumber > domain::TOTAL_CHASSIS_COUNT ||
+            boardNumber < 1 || boardNumber > domain::BOARDS_PER_CHASSIS ||
+            taskIndex < 1 || taskIndex > domain::MAX_TASKS_PER_BOARD) {
+            return std::nullopt;
+        }
+        
+        std::shared_lock lock(m_mutex);  // 读锁
+        
+        const auto& slot = (*m_taskSlots)[chassisNumber - 1][boardNumber - 1][taskIndex - 1];
+        if (slot.taskID[0] == '\0') {
+            return std::nullopt;
+        }
+        
+        domain::TaskSlotView view;
+        std::memcpy(view.taskID, slot.taskID, sizeof(view.taskID));
+        std::memcpy(view.taskStatus, slot.taskStatus, sizeof(view.taskStatus));
+        std::memcpy(view.boardAddress, slot.boardAddress, sizeof(view.boardAddress));
+        if (slot.task != nullptr) {
+            view.resources = slot.task->GetResources();
+            view.hasResources = true;
+        }
+        return view;
+    }
+
     /**
      * @brief 移除一个业务链路
      */
     bool Remove(const std::string& stackUUID) override {
-        std::unique_lock lock(m_mutex);  // 写锁
-        return m_stacks.erase(stackUUID) > 0;
+        bool removed = false;
+        {
+            std::unique_lock lock(m_mutex);  // 写锁
+            removed = m_stacks.erase(stackUUID) > 0;
+            if (removed) {
+                ResolveTaskSlots();
+            }
+        }
+        
+        if (removed) {
+            m_version.fetch_add(1, std::memory_order_acq_rel);
+            m_notifier.Notify();
+        }
+        return removed;
     }
 
     /**
      * @brief 清空所有业务链路
      */
     void Clear() override {
-        std::unique_lock lock(m_mutex);  // 写锁
-        m_stacks.clear();
+        {
+            std::unique_lock lock(m_mutex);  // 写锁
+            m_stacks.clear();
+            ResolveTaskSlots();
+        }
+        m_version.fetch_add(1, std::memory_order_acq_rel);
+        m_notifier.Notify();
     }
 
     /**
@@ -225,12 +334,81 @@ class InMemoryStackRepository : public domain::IStackRepository {
         return count;
     }
 
+    /**
+     * @brief 注册变更监听器（写操作释放写锁后调用）
+     */
+    void AddChangeListener(domain::RepositoryChangeListener listener) override {
+        m_notifier.Add(std::move(listener));
+    }
+
+    /**
+     * @brief 获取当前数据版本号（无锁）
+     */
+    uint64_t GetVersion() const override {
+        return m_version.load(std::memory_order_acquire);
+    }
+
 private:
+    /**
+     * @brief 位置索引中的一个任务槽
+     */
+    struct TaskSlot {
+        char taskID[64] = {};                   // 任务ID（来自boardinfo）
+        char taskStatus[32] = {};               // 任务状态（来自boardinfo）
+        char boardAddress[16] = {};             // 板卡IP地址
+        const domain::Task* task = nullptr;     // 指向m_stacks中的任务（每次写操作后重新解析）
+    };
+    
+    using TaskSlotTable = std::array<
+        std::array<std::array<TaskSlot, domain::MAX_TASKS_PER_BOARD>, domain::BOARDS_PER_CHASSIS>,
+        domain::TOTAL_CHASSIS_COUNT>;
+
+    /**
+     * @brief 将位置索引中的任务ID解析为m_stacks中的任务指针
+     * 
+     * 写操作会使旧指针失效，因此必须在每次修改m_stacks后（持有写锁）调用。
+     */
+    void ResolveTaskSlots() {
+        std::unordered_map<std::string_view, const domain::Task*> tasksByID;
+        for (const auto& [uuid, stack] : m_stacks) {
+            for (const auto& [serviceUUID, service] : stack.GetAllServices()) {
+                for (const auto& [taskID, task] : service.GetAllTasks()) {
+                    tasksByID.emplace(task.GetTaskID(), &task);
+                }
+            }
+        }
+        
+        for (auto& chassisSlots : *m_taskSlots) {
+            for (auto& boardSlots : chassisSlots) {
+                for (auto& slot : boardSlots) {
+                    if (slot.taskID[0] == '\0') {
+                        slot.task = nullptr;
+                        continue;
+                    }
+                    auto it = tasksByID.find(std::string_view(slot.taskID));
+                    slot.task = (it != tasksByID.end()) ? it->second : nullptr;
+                }
+            }
+        }
+    }
+
+    static void CopyString(char* dest, size_t destSize, const char* src) {
+        std::strncpy(dest, src, destSize - 1);
+        dest[destSize - 1] = '\0';
+    }
+
     // 存储：Key = stackUUID, Value = Stack聚合根
     std::map<std::string, domain::Stack> m_stacks;
     
+    // 位置索引（约120KB，堆分配）
+    std::unique_ptr<TaskSlotTable> m_taskSlots;
+    
     // 读写锁（C++17）
     mutable std::shared_mutex m_mutex;
+    
+    // 变更通知
+    ChangeNotifier m_notifier;
+    std::atomic<uint64_t> m_version{0};     // 数据版本号（每次写操作后递增）
 };
 
 } // namespace zygl::infrastructure
@@ -6,6 +6,8 @@
 #include "third_party/json.hpp"
 #include <thread>
 #include <atomic>
+#include <functional>
+#include <iostream>
 #include <memory>
 #include <string>
 
@@ -13,6 +15,14 @@ namespace zygl::interfaces {
 
 using json = nlohmann::json;
 
+/**
+ * @brief Webhook通知涉及的数据（决定数据采集刷新哪个接口）
+ */
+enum class RefreshTarget {
+    Boards,         // 板卡状态（boardinfo）
+    Stacks          // 业务链路状态（stackinfo）
+};
+
 /**
  * @brief WebhookListener - HTTP Webhook监听器
  * 
@@ -23,6 +33,8 @@ using json = nlohmann::json;
  *    - POST /webhook/alert - 接收告警
  *    - POST /webhook/status - 接收状态变化
  *    - POST /webhook/board - 接收板卡上下线通知
+ * 4. 状态变化和板卡上下线通知触发数据采集立即刷新对应数据（见SetRefreshHintListener）；
+ *    板卡上下线同时交给数据采集排队写入在线状态（见SetBoardPresenceListener），状态广播不必等待boardinfo返回
  * 
  * 线程安全：
  * - 运行在独立线程中（cpp-httplib的HTTP服务器）
@@ -54,6 +66,28 @@ class WebhookListener {
         Stop();
     }
 
+    /**
+     * @brief 设置刷新提示监听器
+     * 
+     * 收到业务链路状态变化（Stacks）或板卡上下线（Boards）通知时调用，
+     * 用于让数据采集立即从后端刷新对应数据。
+     * 监听器在HTTP处理线程中同步执行，应尽快返回；应在Start()之前设置。
+     */
+    void SetRefreshHintListener(std::function<void(RefreshTarget)> listener) {
+        m_refreshHintListener = std::move(listener);
+    }
+
+    /**
+     * @brief 设置板卡上下线监听器
+     * 
+     * 收到板卡上下线通知时调用（板卡地址，是否在线），用于让数据采集线程
+     * 尽快写入在线状态（机箱仓储只由采集线程写入）。
+     * 监听器在HTTP处理线程中同步执行，应尽快返回；应在Start()之前设置。
+     */
+    void SetBoardPresenceListener(std::function<void(const std::string&, bool)> listener) {
+        m_boardPresenceListener = std::move(listener);
+    }
+
     /**
      * @brief 启动监听器
      * 
@@ -213,16 +247,15 @@ class WebhookListener {
 
             std::string eventType = requestData.value("eventType", "");
             std::string stackUUID = requestData.value("stackUUID", "");
-            int newStatus = requestData.value("newStatus", 0);
-            uint64_t timestamp = requestData.value("timestamp", 0ULL);
 
-            // 根据eventType处理不同的状态变化
-            // 这里可以根据需要调用相应的服务来处理状态变化
-            // 目前只是记录日志并返回成功
+            // 业务链路状态以stackinfo为准：立即刷新（多个通知合并为一次），不在此处修改仓储
+            NotifyRefreshHint(RefreshTarget::Stacks);
 
             json responseData = {
                 {"success", true},
-                {"message", "状态变化已接收"}
+                {"message", "状态变化已接收"},
+                {"eventType", eventType},
+                {"stackUUID", stackUUID}
             };
             res.set_content(responseData.dump(), "application/json");
             res.status = 200;
@@ -257,10 +290,14 @@ class WebhookListener {
             int chassisNumber = requestData.value("chassisNumber", 0);
             int slotNumber = requestData.value("slotNumber", 0);
             std::string eventType = requestData.value("eventType", "");
-            uint64_t timestamp = requestData.value("timestamp", 0ULL);
 
-            // 根据eventType处理板卡上下线
-            // 如果是offline，应该创建一个告警
+            // 上下线先写入在线状态（状态广播随之推送），再刷新boardinfo获取任务等完整信息
+            if ((eventType == "offline" || eventType == "online") && m_boardPresenceListener) {
+                m_boardPresenceListener(boardAddress, eventType == "online");
+            }
+            NotifyRefreshHint(RefreshTarget::Boards);
+
+            // 离线时创建告警
             if (eventType == "offline") {
                 std::string chassisName = "机箱" + std::to_string(chassisNumber);
                 std::string boardName = "槽位" + std::to_string(slotNumber);
@@ -302,9 +339,17 @@ class WebhookListener {
         }
     }
 
+    void NotifyRefreshHint(RefreshTarget target) {
+        if (m_refreshHintListener) {
+            m_refreshHintListener(target);
+        }
+    }
+
 private:
     // 依赖服务
     std::shared_ptr<application::AlertService> m_alertService;
+    std::function<void(RefreshTarget)> m_refreshHintListener;   // 状态变化时提示数据采集刷新
+    std::function<void(const std::string&, bool)> m_boardPresenceListener;  // 板卡上下线时通知数据采集
     
     // 配置参数
     uint16_t m_listenPort;                      // 监听端口
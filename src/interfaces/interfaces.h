@@ -11,6 +11,14 @@
  * 主要组件：
  * 1. UDP通信
  *    - udp_protocol.h: UDP通信协议定义（数据包格式）
+ *    - udp_batch_sender.h: 批量发送器（sendmmsg）
+ *    - udp_batch_receiver.h: 批量接收器（recvmmsg + eventfd停止信号）
+ *    - resource_monitor_cache.h: 资源监控报文编码缓存
+ *    - payload_compressor.h: 告警/标签载荷压缩
+ *    - token_bucket_pacer.h: 多播发送限速
+ *    - retransmit_ring.h: 最近发送数据报的重传环（NACK）
+ *    - command_executor.h: 命令执行线程池（有界队列）
+ *    - command_dedup_cache.h: 重发命令去重缓存
  *    - state_broadcaster.h: 状态广播器（服务端->前端）
  *    - command_listener.h: 命令监听器（前端->服务端）
  * 
@@ -20,6 +28,14 @@
 
 // UDP通信
 #include "udp/udp_protocol.h"
+#include "udp/udp_batch_sender.h"
+#include "udp/udp_batch_receiver.h"
+#include "udp/resource_monitor_cache.h"
+#include "udp/payload_compressor.h"
+#include "udp/token_bucket_pacer.h"
+#include "udp/retransmit_ring.h"
+#include "udp/command_executor.h"
+#include "udp/command_dedup_cache.h"
 #include "udp/state_broadcaster.h"
 #include "udp/command_listener.h"
 
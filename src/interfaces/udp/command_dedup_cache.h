@@ -0,0 +1,292 @@
+#pragma once
+
+#include "udp_protocol.h"
+#include <netinet/in.h>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <atomic>
+
+namespace zygl::interfaces {
+
+/**
+ * @brief 命令去重键：发送方IP + 命令类型 + 命令ID
+ *
+ * 不包含端口：前端重发时可能使用新的临时端口。
+ */
+struct CommandKey {
+    uint32_t senderIP = 0;          // 发送方IPv4地址（网络字节序）
+    uint16_t commandType = 0;       // 命令类型（PacketType）
+    uint64_t commandID = 0;         // 命令ID
+
+    bool operator==(const CommandKey& other) const {
+        return senderIP == other.senderIP &&
+               commandType == other.commandType &&
+               commandID == other.commandID;
+    }
+};
+
+struct CommandKeyHash {
+    size_t operator()(const CommandKey& key) const {
+        uint64_t h = key.commandID * 0x9E3779B97F4A7C15ULL;
+        h ^= (static_cast<uint64_t>(key.senderIP) << 16) | key.commandType;
+        h ^= h >> 29;
+        return static_cast<size_t>(h);
+    }
+};
+
+/**
+ * @brief 去重缓存统计快照
+ */
+struct CommandDedupStats {
+    uint64_t completedHits = 0;     // 已完成命令的重复请求数（直接回复缓存的响应）
+    uint64_t inFlightHits = 0;      // 执行中命令的重复请求数（不重复执行）
+    uint64_t evictions = 0;         // 因容量上限提前淘汰的记录数
+    uint64_t rejected = 0;          // 记录已满且都在执行中而拒绝登记的次数
+    size_t entries = 0;             // 当前记录数
+};
+
+/**
+ * @brief CommandDedupCache - 命令去重缓存
+ *
+ * 前端收不到响应时会重发命令。缓存在时间窗口内记录每个(发送方, 命令ID)的状态：
+ * - 首次到达：登记为执行中，正常执行
+ * - 执行中重复到达：不重复执行，等待原命令完成（最终结果由原命令的响应送达）
+ * - 已完成重复到达：直接回复缓存的最终响应，不再调用业务逻辑
+ *
+ * 已完成的记录在完成后ttl到期；执行中的记录不会到期，也不会被淘汰（直到完成或撤销）。
+ * 记录数有上限，超出时淘汰最早完成的记录；只剩执行中的记录时拒绝登记（Busy），
+ * 避免重发的命令被当作首次到达而重复执行。
+ *
+ * 线程安全：
+ * - 所有方法都可以被任意线程并发调用（内部互斥锁，临界区只做哈希查找）
+ */
+class CommandDedupCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t MAX_WAITERS = 4;    // 每条执行中记录最多保存的重发方地址数
+
+    enum class State {
+        New,            // 首次到达，调用方应执行命令
+        InFlight,       // 原命令正在执行
+        Completed,      // 原命令已完成，cachedResponse为缓存的响应数据报
+        Busy            // 记录已满且都在执行中，未登记，调用方不应执行（回复繁忙）
+    };
+
+    /**
+     * @brief 构造函数
+     *
+     * @param ttl 记录保留时间，0表示禁用去重
+     * @param maxEntries 最多保留的记录数
+     */
+    explicit CommandDedupCache(std::chrono::milliseconds ttl = std::chrono::seconds(30),
+                               size_t maxEntries = 4096)
+        : m_ttl(ttl), m_maxEntries(maxEntries > 0 ? maxEntries : 1) {
+    }
+
+    // 禁止拷贝
+    CommandDedupCache(const CommandDedupCache&) = delete;
+    CommandDedupCache& operator=(const CommandDedupCache&) = delete;
+
+    /**
+     * @brief 设置记录保留时间（0表示禁用去重，应在开始接收命令之前调用）
+     */
+    void SetTtl(std::chrono::milliseconds ttl) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ttl = ttl;
+    }
+
+    /**
+     * @brief 登记一个到达的命令
+     *
+     * @param key 命令键
+     * @param senderAddr 发送方地址（执行中重复到达时记录，完成时通知）
+     * @param cachedResponse 输出：状态为Completed时为缓存的最终响应（编码后的数据报）
+     * @return 命令状态
+     */
+    State Begin(const CommandKey& key, const struct sockaddr_in& senderAddr,
+                std::vector<char>& cachedResponse) {
+        auto now = Clock::now();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_ttl.count() <= 0) {
+            return State::New;
+        }
+
+        Sweep(now);
+
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            if (it->second.completed) {
+                cachedResponse = it->second.response;
+                m_completedHits.fetch_add(1, std::memory_order_relaxed);
+                return State::Completed;
+            }
+            m_inFlightHits.fetch_add(1, std::memory_order_relaxed);
+            AddWaiter(it->second, senderAddr);
+            return State::InFlight;
+        }
+
+        if (m_entries.size() >= m_maxEntries && !EvictOldestCompleted()) {
+            m_rejected.fetch_add(1, std::memory_order_relaxed);
+            return State::Busy;
+        }
+
+        Entry& entry = m_entries[key];
+        entry.expiresAt = now + m_ttl;
+        entry.waiters.push_back(senderAddr);  // 原命令的发送方
+        m_expiryQueue.push_back({key, entry.expiresAt});
+        return State::New;
+    }
+
+    /**
+     * @brief 记录命令的最终响应（之后的重复请求直接回复该响应）
+     *
+     * @param response 编码后的响应数据报（CommandResponsePacket或批量命令响应）
+     * @param length 数据报长度
+     * @return 执行期间重发过该命令、且地址与原发送方不同的地址（应同样收到最终响应）
+     */
+    std::vector<struct sockaddr_in> Complete(const CommandKey& key, const char* response, size_t length) {
+        auto now = Clock::now();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            return {};  // 已过期或去重已禁用
+        }
+        it->second.completed = true;
+        it->second.response.assign(response, response + length);
+        it->second.expiresAt = now + m_ttl;
+        m_expiryQueue.push_back({key, it->second.expiresAt});
+
+        std::vector<struct sockaddr_in> waiters;
+        if (it->second.waiters.size() > 1) {
+            waiters.assign(it->second.waiters.begin() + 1, it->second.waiters.end());
+        }
+        it->second.waiters.clear();
+        it->second.waiters.shrink_to_fit();
+        return waiters;
+    }
+
+    /**
+     * @brief 撤销登记（命令未执行，如执行队列已满；允许前端重试）
+     */
+    void Abandon(const CommandKey& key) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.erase(key);
+    }
+
+    /**
+     * @brief 获取统计快照
+     */
+    CommandDedupStats GetStats() const {
+        CommandDedupStats stats;
+        stats.completedHits = m_completedHits.load(std::memory_order_relaxed);
+        stats.inFlightHits = m_inFlightHits.load(std::memory_order_relaxed);
+        stats.evictions = m_evictions.load(std::memory_order_relaxed);
+        stats.rejected = m_rejected.load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            stats.entries = m_entries.size();
+        }
+        return stats;
+    }
+
+private:
+    struct Entry {
+        bool completed = false;
+        std::vector<char> response;                 // 最终响应数据报
+        Clock::time_point expiresAt;
+        std::vector<struct sockaddr_in> waiters;    // 执行中：原发送方 + 不同地址的重发方
+    };
+
+    /**
+     * @brief 记录执行中命令的重发方地址（去重，调用方持有锁）
+     */
+    static void AddWaiter(Entry& entry, const struct sockaddr_in& senderAddr) {
+        if (entry.waiters.size() >= MAX_WAITERS) {
+            return;
+        }
+        for (const auto& waiter : entry.waiters) {
+            if (waiter.sin_addr.s_addr == senderAddr.sin_addr.s_addr &&
+                waiter.sin_port == senderAddr.sin_port) {
+                return;
+            }
+        }
+        entry.waiters.push_back(senderAddr);
+    }
+
+    // 过期队列按登记/更新顺序排列（ttl相同，因此也是到期顺序）；
+    // 记录更新后旧的队列项失效（到期时间与记录中的不一致），撤销后的队列项也失效
+    struct ExpiryItem {
+        CommandKey key;
+        Clock::time_point expiresAt;
+    };
+
+    /**
+     * @brief 队列项对应的记录（队列项已失效时返回end）
+     */
+    std::unordered_map<CommandKey, Entry, CommandKeyHash>::iterator FindCurrent(const ExpiryItem& item) {
+        auto it = m_entries.find(item.key);
+        if (it != m_entries.end() && it->second.expiresAt != item.expiresAt) {
+            return m_entries.end();
+        }
+        return it;
+    }
+
+    /**
+     * @brief 清理到期记录（调用方持有锁）
+     *
+     * 执行中的记录不清理：其队列项出队后，完成时Complete()会登记新的队列项。
+     */
+    void Sweep(Clock::time_point now) {
+        while (!m_expiryQueue.empty() && m_expiryQueue.front().expiresAt <= now) {
+            auto it = FindCurrent(m_expiryQueue.front());
+            if (it != m_entries.end() && it->second.completed) {
+                m_entries.erase(it);
+            }
+            m_expiryQueue.pop_front();
+        }
+    }
+
+    /**
+     * @brief 淘汰最早完成的一条记录（调用方持有锁）
+     *
+     * 顺带丢弃遇到的失效队列项；执行中记录的队列项保留。
+     *
+     * @return false 如果没有可淘汰的已完成记录
+     */
+    bool EvictOldestCompleted() {
+        for (auto item = m_expiryQueue.begin(); item != m_expiryQueue.end();) {
+            auto it = FindCurrent(*item);
+            if (it == m_entries.end()) {
+                item = m_expiryQueue.erase(item);
+                continue;
+            }
+            if (!it->second.completed) {
+                ++item;
+                continue;
+            }
+            m_entries.erase(it);
+            m_expiryQueue.erase(item);
+            m_evictions.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    std::chrono::milliseconds m_ttl;
+    size_t m_maxEntries;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<CommandKey, Entry, CommandKeyHash> m_entries;
+    std::deque<ExpiryItem> m_expiryQueue;
+
+    std::atomic<uint64_t> m_completedHits{0};
+    std::atomic<uint64_t> m_inFlightHits{0};
+    std::atomic<uint64_t> m_evictions{0};
+    std::atomic<uint64_t> m_rejected{0};
+};
+
+} // namespace zygl::interfaces
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace zygl::interfaces {
+
+/**
+ * @brief 命令执行统计快照
+ */
+struct CommandExecutorStats {
+    uint64_t submitted = 0;         // 进入队列的任务数
+    uint64_t rejected = 0;          // 队列已满被拒绝的任务数
+    uint64_t completed = 0;         // 执行完成的任务数
+    uint64_t discarded = 0;         // 停止时仍在队列中、未执行的任务数（已调用其丢弃回调）
+    size_t queueDepth = 0;          // 当前队列长度
+    size_t maxQueueDepth = 0;       // 队列长度峰值
+};
+
+/**
+ * @brief CommandExecutor - 命令执行线程池（有界队列）
+ *
+ * 将耗时的命令（部署/卸载会同步调用后端HTTP接口）从接收线程中剥离：
+ * 接收线程只负责入队，工作线程执行并发送完成响应。
+ * 队列有界，满时TrySubmit()立即返回false，由调用方回复"繁忙"，不阻塞接收线程。
+ * 停止时队列中尚未执行的任务不执行，改为调用提交时给出的丢弃回调（如回复"繁忙"），
+ * 已回复"已受理"的命令也能收到最终结果。
+ *
+ * 线程安全：
+ * - TrySubmit()和GetStats()可以被任意线程并发调用
+ * - Start()/Stop()由所属对象的启停流程调用
+ */
+class CommandExecutor {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief 构造函数
+     *
+     * @param workerCount 工作线程数（至少1）
+     * @param queueCapacity 队列容量（至少1）
+     */
+    explicit CommandExecutor(size_t workerCount = 2, size_t queueCapacity = 64)
+        : m_workerCount(workerCount > 0 ? workerCount : 1),
+          m_queueCapacity(queueCapacity > 0 ? queueCapacity : 1),
+          m_running(false) {
+    }
+
+    ~CommandExecutor() {
+        Stop();
+    }
+
+    // 禁止拷贝
+    CommandExecutor(const CommandExecutor&) = delete;
+    CommandExecutor& operator=(const CommandExecutor&) = delete;
+
+    /**
+     * @brief 设置线程数和队列容量（应在Start()之前调用）
+     */
+    void Configure(size_t workerCount, size_t queueCapacity) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_running) {
+            return;
+        }
+        m_workerCount = workerCount > 0 ? workerCount : 1;
+        m_queueCapacity = queueCapacity > 0 ? queueCapacity : 1;
+    }
+
+    /**
+     * @brief 启动工作线程
+     */
+    void Start() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_running) {
+            return;
+        }
+        m_running = true;
+        m_workers.reserve(m_workerCount);
+        for (size_t i = 0; i < m_workerCount; ++i) {
+            m_workers.emplace_back(&CommandExecutor::WorkerLoop, this);
+        }
+    }
+
+    /**
+     * @brief 停止工作线程
+     *
+     * 正在执行的任务会执行完毕；队列中尚未开始的任务不执行，在当前线程依次调用其丢弃回调。
+     */
+    void Stop() {
+        std::deque<QueuedTask> discarded;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_running) {
+                return;
+            }
+            m_running = false;
+            discarded.swap(m_queue);
+        }
+        m_cv.notify_all();
+
+        m_discarded.fetch_add(discarded.size(), std::memory_order_relaxed);
+        for (auto& queued : discarded) {
+            if (queued.onDiscard) {
+                RunGuarded(queued.onDiscard);
+            }
+        }
+
+        for (auto& worker : m_workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        m_workers.clear();
+    }
+
+    /**
+     * @brief 提交任务（不阻塞）
+     *
+     * @param task 任务
+     * @param onDiscard 执行器停止时任务仍在队列中、未执行时调用（可为空）
+     * @return true 如果已入队；false 如果队列已满或执行器未运行
+     */
+    bool TrySubmit(Task task, Task onDiscard = nullptr) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_running || m_queue.size() >= m_queueCapacity) {
+                m_rejected.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            m_queue.push_back({std::move(task), std::move(onDiscard)});
+            m_maxQueueDepth = std::max(m_maxQueueDepth, m_queue.size());
+        }
+        m_submitted.fetch_add(1, std::memory_order_relaxed);
+        m_cv.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief 获取统计快照
+     */
+    CommandExecutorStats GetStats() const {
+        CommandExecutorStats stats;
+        stats.submitted = m_submitted.load(std::memory_order_relaxed);
+        stats.rejected = m_rejected.load(std::memory_order_relaxed);
+        stats.completed = m_completed.load(std::memory_order_relaxed);
+        stats.discarded = m_discarded.load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            stats.queueDepth = m_queue.size();
+            stats.maxQueueDepth = m_maxQueueDepth;
+        }
+        return stats;
+    }
+
+private:
+    struct QueuedTask {
+        Task run;           // 任务
+        Task onDiscard;     // 未执行而被丢弃时的回调
+    };
+
+    /**
+     * @brief 执行任务，捕获并记录异常
+     */
+    static void RunGuarded(const Task& task) {
+        try {
+            task();
+        } catch (const std::exception& e) {
+            std::cerr << "CommandExecutor: 命令执行异常 - " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "CommandExecutor: 命令执行未知异常" << std::endl;
+        }
+    }
+
+    /**
+     * @brief 工作线程循环
+     */
+    void WorkerLoop() {
+        while (true) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this]() { return !m_running || !m_queue.empty(); });
+                if (!m_running) {
+                    return;
+                }
+                task = std::move(m_queue.front().run);
+                m_queue.pop_front();
+            }
+
+            RunGuarded(task);
+            m_completed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    size_t m_workerCount;                   // 工作线程数
+    size_t m_queueCapacity;                 // 队列容量
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<QueuedTask> m_queue;         // 待执行任务
+    std::vector<std::thread> m_workers;     // 工作线程
+    bool m_running;                         // 是否运行（受m_mutex保护）
+    size_t m_maxQueueDepth = 0;             // 队列长度峰值（受m_mutex保护）
+
+    std::atomic<uint64_t> m_submitted{0};
+    std::atomic<uint64_t> m_rejected{0};
+    std::atomic<uint64_t> m_completed{0};
+    std::atomic<uint64_t> m_discarded{0};
+};
+
+} // namespace zygl::interfaces
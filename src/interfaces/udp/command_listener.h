@@ -1,35 +1,90 @@
 #pragma once
 
 #include "udp_protocol.h"
+#include "resource_monitor_cache.h"
+#include "retransmit_ring.h"
+#include "retransmit_limiter.h"
+#include "command_executor.h"
+#include "udp_batch_receiver.h"
+#include "command_dedup_cache.h"
 #include "../../application/services/stack_control_service.h"
 #include "../../application/services/alert_service.h"
+#include "../../application/services/monitoring_service.h"
+#include "../../infrastructure/metrics/latency_histogram.h"
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <thread>
 #include <atomic>
 #include <memory>
+#include <mutex>
+#include <cstddef>
 #include <cstring>
 #include <functional>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
 
 namespace zygl::interfaces {
 
+/**
+ * @brief 命令优先级通道
+ * 
+ * 各通道有独立的队列和线程，慢速的部署/卸载不会阻塞确认告警和只读查询。
+ */
+enum class CommandLane {
+    Inline,         // 接收线程内直接处理：只读查询（F000H/F005H、NACK），不排队
+    Interactive,    // 交互通道：操作员确认告警（需要告警仓储写锁）
+    Bulk            // 批量通道：部署/卸载（同步调用后端HTTP接口）
+};
+
+/**
+ * @brief 单类命令的延迟分布
+ */
+struct CommandLatencyStats {
+    std::string command;                        // 命令名称
+    infrastructure::LatencySummary dispatch;    // 接收 -> 开始执行（部署/卸载含排队时间）
+    infrastructure::LatencySummary execute;     // 开始执行 -> 业务逻辑/后端返回
+    infrastructure::LatencySummary total;       // 接收 -> 最终响应发出
+};
+
 /**
  * @brief CommandListener - UDP命令监听器
  * 
  * 职责：
  * 1. 监听前端发送的UDP命令（加入多播组）
  * 2. 解析命令并调用相应的应用服务
- * 3. 发送命令响应包到前端
+ * 3. 以单播向命令发送方回复响应包（可选多播审计回显）
  * 
  * 支持的命令：
  * - 部署业务链（DeployStack）
  * - 卸载业务链（UndeployStack）
  * - 确认告警（AcknowledgeAlert）
+ * - 资源监控报文请求（F000H），以单播回复缓存的编码报文
+ * - 任务查看报文请求（F005H），以单播回复F105H（按位置常数时间查找）
+ * - 重传请求（RetransmitRequest/NACK），从重传环以单播重传原数据报（需配置允许网段；单次上限、按发送方和全局限速）
+ * - 批量命令（BatchCommand），一个数据报携带多个确认/部署/卸载子命令，一次执行、一个逐项结果响应
+ * 
+ * 命令按类型分为三个优先级通道（CommandLane），各自独立的队列和线程：
+ * - 只读查询（F000H/F005H、重传请求）：在接收线程内直接处理，从不排队
+ * - 确认告警：交互通道（独立的有界执行线程池），不受告警仓储写锁竞争影响接收线程
+ * - 部署/卸载：批量通道，同步调用后端HTTP接口；接收线程立即回复Accepted，
+ *   执行完成后再回复最终结果
+ * 通道队列满时回复Busy。
+ * 
+ * 前端重发的部署/卸载/确认命令按(发送方IP, 命令ID)去重（CommandDedupCache）：
+ * 已完成的直接重发缓存的响应，执行中的不重复执行。
+ * 
+ * 可配置多个接收分片（SO_REUSEPORT），每个分片独立的socket和线程，命令吞吐随核数扩展。
+ * 
+ * 每类命令记录三段延迟直方图（接收->执行、执行->返回、总耗时），总耗时超过SLO阈值时输出日志。
  * 
  * 线程安全：
- * - 运行在独立线程中
+ * - 每个接收分片运行在独立线程中，部署/卸载在执行线程池中执行
  * - 通过std::atomic<bool>控制启停
  */
 class CommandListener {
@@ -39,14 +94,22 @@ class CommandListener {
      * 
      * @param stackControlService 业务链控制服务
      * @param alertService 告警服务
+     * @param resourceMonitorCache 资源监控报文缓存（为空时忽略F000H请求）
+     * @param monitoringService 监控服务（为空时忽略F005H请求）
+     * @param retransmitRing 广播重传环（为空时忽略重传请求）
      */
     CommandListener(
         std::shared_ptr<application::StackControlService> stackControlService,
-        std::shared_ptr<application::AlertService> alertService)
+        std::shared_ptr<application::AlertService> alertService,
+        std::shared_ptr<ResourceMonitorCache> resourceMonitorCache = nullptr,
+        std::shared_ptr<application::MonitoringService> monitoringService = nullptr,
+        std::shared_ptr<RetransmitRing> retransmitRing = nullptr)
         : m_stackControlService(stackControlService),
           m_alertService(alertService),
+          m_resourceMonitorCache(resourceMonitorCache),
+          m_monitoringService(monitoringService),
+          m_retransmitRing(retransmitRing),
           m_running(false),
-          m_socketFd(-1),
           m_responseFd(-1) {
     }
 
@@ -58,70 +121,206 @@ class CommandListener {
     }
 
     /**
-     * @brief 启动监听器
+     * @brief 配置优先级通道的执行线程池（应在Start()之前调用）
      * 
-     * @return true 如果启动成功，false 如果失败
+     * @param lane 通道（Interactive或Bulk；Inline通道没有线程池，忽略）
+     * @param workerCount 工作线程数
+     * @param queueCapacity 等待执行的命令数上限，超出时回复Busy
      */
-    bool Start() {
-        if (m_running.load()) {
-            return false;  // 已经在运行
+    void ConfigureLane(CommandLane lane, size_t workerCount, size_t queueCapacity) {
+        if (CommandExecutor* executor = ExecutorFor(lane)) {
+            executor->Configure(workerCount, queueCapacity);
         }
+    }
 
-        // 创建接收socket
-        m_socketFd = socket(AF_INET, SOCK_DGRAM, 0);
-        if (m_socketFd < 0) {
-            return false;
+    /**
+     * @brief 设置接收分片数（应在Start()之前调用）
+     * 
+     * 每个分片是一个独立的接收socket（SO_REUSEPORT绑定同一端口）和接收线程：
+     * - 单播到本机的命令由内核按四元组哈希分配给某一个分片
+     * - 多播命令会复制给每个分片，各分片只处理发送方哈希到自己的数据报
+     * 同一前端的命令总是由同一个分片处理（保持顺序）。
+     * 
+     * @param shardCount 分片数（至少1）
+     */
+    void SetShardCount(size_t shardCount) {
+        m_shardCount = shardCount > 0 ? shardCount : 1;
+    }
+
+    /**
+     * @brief 设置接收socket的SO_RCVBUF（应在Start()之前调用，每个分片单独生效）
+     * 
+     * @param receiveBufferBytes 字节数，<=0表示使用系统默认值
+     */
+    void SetReceiveBufferBytes(int receiveBufferBytes) {
+        m_receiveBufferBytes = receiveBufferBytes;
+    }
+
+    /**
+     * @brief 获取接收统计（所有分片合计：数据报数、批次数、内核丢包数）
+     *
+     * 可以与Start()/Stop()并发调用；已关闭分片的计数保留，重启后继续累加。
+     */
+    UdpReceiveStats GetReceiveStats() const {
+        std::lock_guard<std::mutex> lock(m_shardsMutex);
+        UdpReceiveStats total = m_closedShardStats;
+        for (const auto& shard : m_shards) {
+            AddReceiveStats(total, shard->receiver.GetStats());
         }
+        return total;
+    }
 
-        // 设置socket选项：允许地址重用
-        int reuse = 1;
-        if (setsockopt(m_socketFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0) {
-            close(m_socketFd);
-            m_socketFd = -1;
-            return false;
+    /**
+     * @brief 设置命令去重窗口（应在Start()之前调用）
+     * 
+     * @param window 同一命令ID的重发在窗口内不会重复执行，0表示禁用去重
+     */
+    void SetDedupWindow(std::chrono::milliseconds window) {
+        m_dedupCache.SetTtl(window);
+    }
+
+    /**
+     * @brief 获取命令去重统计
+     */
+    CommandDedupStats GetDedupStats() const {
+        return m_dedupCache.GetStats();
+    }
+
+    /**
+     * @brief 设置命令最终结果的多播审计回显
+     * 
+     * 命令响应总是以单播回复发送方；开启后最终结果（不含Accepted/Busy）
+     * 再向多播组（STATE_BROADCAST_PORT）发送一份，供审计/旁路监听。
+     * 
+     * @param enabled 是否开启（默认关闭）
+     */
+    void SetAuditEcho(bool enabled) {
+        m_auditEcho.store(enabled);
+    }
+
+    /**
+     * @brief 设置命令响应时间SLO阈值（接收到最终响应发出），超过时输出日志
+     * 
+     * @param threshold 阈值，0表示不检查
+     */
+    void SetResponseSlo(std::chrono::milliseconds threshold) {
+        m_slo.SetThreshold(threshold);
+    }
+
+    /**
+     * @brief 设置重传请求（NACK）的限制
+     * 
+     * @param allowedSubnet 允许发送NACK的网段（如"192.168.1.0/24"），空字符串表示不响应NACK
+     * @param packetsPerSecond 每个发送方每秒最多重传的数据报数，0表示不限制
+     * @param bytesPerSecond 每个发送方每秒最多重传的字节数，0表示不限制
+     * @param totalPacketsPerSecond 所有发送方合计每秒最多重传的数据报数，0表示不限制
+     * @param totalBytesPerSecond 所有发送方合计每秒最多重传的字节数，0表示不限制
+     * @return false 如果网段格式无效（保持不响应NACK）
+     */
+    bool SetRetransmitLimits(const std::string& allowedSubnet, uint32_t packetsPerSecond, uint64_t bytesPerSecond,
+                             uint32_t totalPacketsPerSecond, uint64_t totalBytesPerSecond) {
+        m_retransmitLimiter.SetSenderRate(packetsPerSecond, bytesPerSecond);
+        m_retransmitLimiter.SetTotalRate(totalPacketsPerSecond, totalBytesPerSecond);
+        return m_retransmitLimiter.SetAllowedSubnet(allowedSubnet);
+    }
+
+    /**
+     * @brief 获取重传统计（请求数、丢弃数、重传数和被限制的数据报数）
+     */
+    RetransmitLimiterStats GetRetransmitStats() const {
+        return m_retransmitLimiter.GetStats();
+    }
+
+    /**
+     * @brief 获取各类命令的延迟分布（只包含有样本的命令）
+     */
+    std::vector<CommandLatencyStats> GetLatencyStats() const {
+        std::vector<CommandLatencyStats> result;
+        for (size_t i = 0; i < m_latency.size(); ++i) {
+            const CommandLatency& latency = m_latency[i];
+            if (latency.total.GetCount() == 0) {
+                continue;
+            }
+            CommandLatencyStats stats;
+            stats.command = COMMAND_METRIC_NAMES[i];
+            stats.dispatch = latency.dispatch.GetSummary();
+            stats.execute = latency.execute.GetSummary();
+            stats.total = latency.total.GetSummary();
+            result.push_back(std::move(stats));
         }
+        return result;
+    }
 
-        // 绑定到多播端口
-        struct sockaddr_in localAddr;
-        std::memset(&localAddr, 0, sizeof(localAddr));
-        localAddr.sin_family = AF_INET;
-        localAddr.sin_addr.s_addr = htonl(INADDR_ANY);
-        localAddr.sin_port = htons(COMMAND_LISTEN_PORT);
+    /**
+     * @brief 获取响应时间超过SLO阈值的命令数
+     */
+    uint64_t GetSloBreachCount() const {
+        return m_slo.GetBreachCount();
+    }
 
-        if (bind(m_socketFd, (struct sockaddr*)&localAddr, sizeof(localAddr)) < 0) {
-            close(m_socketFd);
-            m_socketFd = -1;
-            return false;
+    /**
+     * @brief 获取优先级通道的执行统计（Inline通道返回空统计）
+     */
+    CommandExecutorStats GetExecutorStats(CommandLane lane) const {
+        switch (lane) {
+            case CommandLane::Interactive:
+                return m_interactiveExecutor.GetStats();
+            case CommandLane::Bulk:
+                return m_bulkExecutor.GetStats();
+            default:
+                return CommandExecutorStats{};
         }
+    }
 
-        // 加入多播组
-        struct ip_mreq mreq;
-        mreq.imr_multiaddr.s_addr = inet_addr(MULTICAST_GROUP);
-        mreq.imr_interface.s_addr = htonl(INADDR_ANY);
-        
-        if (setsockopt(m_socketFd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
-            close(m_socketFd);
-            m_socketFd = -1;
-            return false;
+    /**
+     * @brief 启动监听器
+     * 
+     * @return true 如果启动成功，false 如果失败
+     */
+    bool Start() {
+        if (m_running.load()) {
+            return false;  // 已经在运行
+        }
+
+        // 创建接收分片（每个分片一个socket）
+        for (size_t i = 0; i < m_shardCount; ++i) {
+            auto shard = std::make_unique<Shard>();
+            shard->socketFd = OpenReceiveSocket(m_shardCount > 1);
+            if (shard->socketFd < 0) {
+                CloseShards();
+                return false;
+            }
+
+            // 批量接收（非阻塞socket + poll + eventfd停止信号）
+            if (!shard->receiver.Attach(shard->socketFd, m_receiveBufferBytes)) {
+                close(shard->socketFd);
+                CloseShards();
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(m_shardsMutex);
+            m_shards.push_back(std::move(shard));
         }
 
         // 创建响应socket（用于发送命令响应）
         m_responseFd = socket(AF_INET, SOCK_DGRAM, 0);
         if (m_responseFd < 0) {
-            close(m_socketFd);
-            m_socketFd = -1;
+            CloseShards();
             return false;
         }
 
-        // 配置多播响应地址
+        // 配置审计回显的多播地址
         std::memset(&m_responseAddr, 0, sizeof(m_responseAddr));
         m_responseAddr.sin_family = AF_INET;
         m_responseAddr.sin_addr.s_addr = inet_addr(MULTICAST_GROUP);
         m_responseAddr.sin_port = htons(STATE_BROADCAST_PORT);
 
-        // 启动监听线程
+        // 启动各通道的执行线程池和各分片的监听线程
+        m_interactiveExecutor.Start();
+        m_bulkExecutor.Start();
         m_running.store(true);
-        m_listenerThread = std::thread(&CommandListener::ListenLoop, this);
+        for (size_t i = 0; i < m_shards.size(); ++i) {
+            m_shards[i]->thread = std::thread(&CommandListener::ListenLoop, this, i);
+        }
 
         return true;
     }
@@ -135,16 +334,21 @@ class CommandListener {
         }
 
         m_running.store(false);
-        
-        if (m_listenerThread.joinable()) {
-            m_listenerThread.join();
+        for (auto& shard : m_shards) {
+            shard->receiver.Wake();  // 唤醒阻塞在poll中的监听线程
         }
-
-        if (m_socketFd >= 0) {
-            close(m_socketFd);
-            m_socketFd = -1;
+        for (auto& shard : m_shards) {
+            if (shard->thread.joinable()) {
+                shard->thread.join();
+            }
         }
 
+        // 等待正在执行的命令完成，队列中未执行的命令回复Busy（响应socket在此之后关闭）
+        m_interactiveExecutor.Stop();
+        m_bulkExecutor.Stop();
+
+        CloseShards();
+
         if (m_responseFd >= 0) {
             close(m_responseFd);
             m_responseFd = -1;
@@ -159,33 +363,168 @@ class CommandListener {
     }
 
 private:
+    using Clock = std::chrono::steady_clock;
+
     /**
-     * @brief 监听循环（运行在独立线程）
+     * @brief 延迟统计的命令分类
      */
-    void ListenLoop() {
-        constexpr size_t BUFFER_SIZE = 65536;
-        char buffer[BUFFER_SIZE];
+    enum class CommandMetric : size_t {
+        DeployStack,
+        UndeployStack,
+        AcknowledgeAlert,
+        RetransmitRequest,
+        ResourceMonitor,
+        TaskView,
+        BatchCommand,
+        Count
+    };
 
-        while (m_running.load()) {
-            struct sockaddr_in senderAddr;
-            socklen_t senderLen = sizeof(senderAddr);
-
-            // 接收数据
-            ssize_t recvLen = recvfrom(m_socketFd, buffer, BUFFER_SIZE, 0,
-                                      (struct sockaddr*)&senderAddr, &senderLen);
-
-            if (recvLen < 0) {
-                if (m_running.load()) {
-                    // 只有在运行状态下的错误才需要处理
-                    continue;
-                } else {
-                    break;
-                }
+    static constexpr const char* COMMAND_METRIC_NAMES[] = {
+        "DeployStack", "UndeployStack", "AcknowledgeAlert",
+        "RetransmitRequest", "ResourceMonitor(F000H)", "TaskView(F005H)", "BatchCommand"
+    };
+
+    /**
+     * @brief 解析后的批量子命令
+     */
+    struct BatchItem {
+        uint8_t itemType;               // BatchItemType
+        std::string targetID;           // 告警ID或标签UUID
+    };
+
+    /**
+     * @brief 单类命令的三段延迟直方图
+     */
+    struct CommandLatency {
+        infrastructure::LatencyHistogram dispatch;
+        infrastructure::LatencyHistogram execute;
+        infrastructure::LatencyHistogram total;
+    };
+
+    /**
+     * @brief 接收分片：独立的socket、接收缓冲区和线程
+     */
+    struct Shard {
+        int socketFd = -1;                  // 接收socket文件描述符
+        UdpBatchReceiver receiver;          // 批量接收器（recvmmsg + eventfd停止信号）
+        std::thread thread;                 // 监听线程
+    };
+
+    /**
+     * @brief 创建绑定到命令端口并加入多播组的接收socket
+     * 
+     * @param reusePort 是否设置SO_REUSEPORT（多分片时）
+     * @return socket文件描述符，失败返回-1
+     */
+    static int OpenReceiveSocket(bool reusePort) {
+        int socketFd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (socketFd < 0) {
+            return -1;
+        }
+
+        // 设置socket选项：允许地址重用
+        int reuse = 1;
+        if (setsockopt(socketFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0 ||
+            (reusePort && setsockopt(socketFd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0)) {
+            close(socketFd);
+            return -1;
+        }
+
+        // 只接收本socket加入的多播组（不接收本机其他程序加入的组）
+        int multicastAll = 0;
+        setsockopt(socketFd, IPPROTO_IP, IP_MULTICAST_ALL, &multicastAll, sizeof(multicastAll));
+
+        // 绑定到多播端口
+        struct sockaddr_in localAddr;
+        std::memset(&localAddr, 0, sizeof(localAddr));
+        localAddr.sin_family = AF_INET;
+        localAddr.sin_addr.s_addr = htonl(INADDR_ANY);
+        localAddr.sin_port = htons(COMMAND_LISTEN_PORT);
+
+        if (bind(socketFd, (struct sockaddr*)&localAddr, sizeof(localAddr)) < 0) {
+            close(socketFd);
+            return -1;
+        }
+
+        // 加入多播组
+        struct ip_mreq mreq;
+        mreq.imr_multiaddr.s_addr = inet_addr(MULTICAST_GROUP);
+        mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+        
+        if (setsockopt(socketFd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+            close(socketFd);
+            return -1;
+        }
+
+        return socketFd;
+    }
+
+    /**
+     * @brief 累加接收统计
+     */
+    static void AddReceiveStats(UdpReceiveStats& total, const UdpReceiveStats& stats) {
+        total.packetsReceived += stats.packetsReceived;
+        total.bytesReceived += stats.bytesReceived;
+        total.batches += stats.batches;
+        total.truncated += stats.truncated;
+        total.kernelDrops += stats.kernelDrops;
+        total.receiveErrors += stats.receiveErrors;
+    }
+
+    /**
+     * @brief 关闭所有分片的socket（监听线程已退出），计数并入已关闭分片的统计
+     */
+    void CloseShards() {
+        std::lock_guard<std::mutex> lock(m_shardsMutex);
+        for (auto& shard : m_shards) {
+            AddReceiveStats(m_closedShardStats, shard->receiver.GetStats());
+            shard->receiver.Detach();
+            if (shard->socketFd >= 0) {
+                close(shard->socketFd);
+                shard->socketFd = -1;
+            }
+        }
+        m_shards.clear();
+    }
+
+    /**
+     * @brief 计算多播数据报归属的分片（按发送方地址和端口哈希，各分片结果一致）
+     */
+    size_t ShardOf(const struct sockaddr_in& senderAddr) const {
+        uint64_t h = (static_cast<uint64_t>(senderAddr.sin_addr.s_addr) << 16) | senderAddr.sin_port;
+        h *= 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h >> 32) % m_shards.size();
+    }
+
+    /**
+     * @brief 监听循环（每个分片一个线程）
+     * 
+     * 每次唤醒用recvmmsg批量取出socket中的数据报；Stop()通过eventfd唤醒，立即退出。
+     * 各分片的处理函数并发执行，依赖的服务/缓存均为线程安全。
+     * 
+     * @param shardIndex 分片序号
+     */
+    void ListenLoop(size_t shardIndex) {
+        Shard& shard = *m_shards[shardIndex];
+        bool sharded = m_shards.size() > 1;
+
+        auto onDatagram = [this, shardIndex, sharded](const char* data, size_t length,
+                                                      const struct sockaddr_in& senderAddr,
+                                                      bool multicast) {
+            // 多播数据报每个分片都会收到一份，只由发送方所属的分片处理
+            if (sharded && multicast && ShardOf(senderAddr) != shardIndex) {
+                return;
             }
 
             // 解析并处理命令
-            if (recvLen >= sizeof(UdpPacketHeader)) {
-                ProcessCommand(buffer, recvLen);
+            if (length >= sizeof(UdpPacketHeader)) {
+                ProcessCommand(data, length, senderAddr, Clock::now());
+            }
+        };
+
+        while (m_running.load()) {
+            if (!shard.receiver.Receive(onDatagram)) {
+                break;
             }
         }
     }
@@ -193,26 +532,68 @@ class CommandListener {
     /**
      * @brief 处理接收到的命令
      */
-    void ProcessCommand(const char* data, size_t dataLen) {
+    void ProcessCommand(const char* data, size_t dataLen, const struct sockaddr_in& senderAddr,
+                        Clock::time_point receivedAt) {
+        // 监控类请求（F000H/F005H）：22字节头部之后是命令码，与UdpPacketHeader格式不同，优先识别
+        switch (ReadMonitorCommandCode(data, dataLen)) {
+            case RESOURCE_MONITOR_COMMAND_CODE:
+                if (dataLen >= sizeof(ResourceMonitorRequestPacket)) {
+                    RunTimed(CommandMetric::ResourceMonitor, receivedAt, [&]() {
+                        HandleResourceMonitorRequest(
+                            reinterpret_cast<const ResourceMonitorRequestPacket*>(data), senderAddr);
+                    });
+                }
+                return;
+
+            case TASK_VIEW_REQUEST_CODE:
+                if (dataLen >= sizeof(TaskViewRequestPacket)) {
+                    RunTimed(CommandMetric::TaskView, receivedAt, [&]() {
+                        HandleTaskViewRequest(
+                            reinterpret_cast<const TaskViewRequestPacket*>(data), senderAddr);
+                    });
+                }
+                return;
+
+            default:
+                break;
+        }
+
         const UdpPacketHeader* header = reinterpret_cast<const UdpPacketHeader*>(data);
         PacketType packetType = static_cast<PacketType>(header->packetType);
 
         switch (packetType) {
             case PacketType::DeployStack:
                 if (dataLen >= sizeof(DeployStackCommand)) {
-                    HandleDeployStack(reinterpret_cast<const DeployStackCommand*>(data));
+                    HandleDeployStack(reinterpret_cast<const DeployStackCommand*>(data), senderAddr,
+                                      receivedAt);
                 }
                 break;
 
             case PacketType::UndeployStack:
                 if (dataLen >= sizeof(UndeployStackCommand)) {
-                    HandleUndeployStack(reinterpret_cast<const UndeployStackCommand*>(data));
+                    HandleUndeployStack(reinterpret_cast<const UndeployStackCommand*>(data), senderAddr,
+                                        receivedAt);
                 }
                 break;
 
             case PacketType::AcknowledgeAlert:
                 if (dataLen >= sizeof(AcknowledgeAlertCommand)) {
-                    HandleAcknowledgeAlert(reinterpret_cast<const AcknowledgeAlertCommand*>(data));
+                    HandleAcknowledgeAlert(reinterpret_cast<const AcknowledgeAlertCommand*>(data),
+                                           senderAddr, receivedAt);
+                }
+                break;
+
+            case PacketType::RetransmitRequest:
+                if (dataLen >= RETRANSMIT_REQUEST_PREFIX_SIZE) {
+                    RunTimed(CommandMetric::RetransmitRequest, receivedAt, [&]() {
+                        HandleRetransmitRequest(data, dataLen, senderAddr);
+                    });
+                }
+                break;
+
+            case PacketType::BatchCommand:
+                if (dataLen >= sizeof(BatchCommandHeader)) {
+                    HandleBatchCommand(data, dataLen, senderAddr, receivedAt);
                 }
                 break;
 
@@ -223,91 +604,639 @@ class CommandListener {
     }
 
     /**
-     * @brief 处理部署业务链命令
+     * @brief 在当前线程执行命令处理函数并记录延迟（处理函数内发出响应）
      */
-    void HandleDeployStack(const DeployStackCommand* cmd) {
-        std::string labelUUID(cmd->labelUUID);
+    template<typename Handler>
+    void RunTimed(CommandMetric metric, Clock::time_point receivedAt, Handler&& handler) {
+        Clock::time_point dispatchedAt = Clock::now();
+        handler();
+        RecordLatency(metric, receivedAt, dispatchedAt, Clock::now());
+    }
+
+    /**
+     * @brief 记录一条命令的延迟并检查SLO（应在最终响应发出之后调用）
+     * 
+     * @param receivedAt 数据报取出时间
+     * @param dispatchedAt 开始执行时间
+     * @param returnedAt 业务逻辑/后端返回时间
+     */
+    void RecordLatency(CommandMetric metric, Clock::time_point receivedAt,
+                       Clock::time_point dispatchedAt, Clock::time_point returnedAt) {
+        auto totalUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - receivedAt).count();
+
+        size_t index = static_cast<size_t>(metric);
+        CommandLatency& latency = m_latency[index];
+        latency.dispatch.Record(dispatchedAt - receivedAt);
+        latency.execute.Record(returnedAt - dispatchedAt);
+        latency.total.Record(static_cast<uint64_t>(totalUs));
+        m_slo.Check(COMMAND_METRIC_NAMES[index], static_cast<uint64_t>(totalUs));
+    }
+
+    /**
+     * @brief 读取监控类请求的命令码（第22-23字节）
+     * 
+     * @return 命令码，数据过短时返回0
+     */
+    static uint16_t ReadMonitorCommandCode(const char* data, size_t dataLen) {
+        uint16_t commandCode = 0;
+        if (dataLen >= sizeof(ResourceMonitorHeader) + sizeof(commandCode)) {
+            std::memcpy(&commandCode, data + sizeof(ResourceMonitorHeader), sizeof(commandCode));
+        }
+        return commandCode;
+    }
+
+    /**
+     * @brief 处理资源监控报文请求
+     * 
+     * 以单播方式回复请求方。报文体直接引用缓存中的编码结果（同一快照版本只编码一次），
+     * 通过iovec将响应ID替换为请求ID，不拷贝报文。
+     */
+    void HandleResourceMonitorRequest(const ResourceMonitorRequestPacket* request,
+                                      const struct sockaddr_in& senderAddr) {
+        if (!m_resourceMonitorCache || m_responseFd < 0) {
+            return;
+        }
+
+        auto cached = m_resourceMonitorCache->GetPacket();
+        if (!cached) {
+            return;
+        }
+
+        uint32_t responseID = request->requestID;  // 响应ID等于请求ID
+        const char* body = reinterpret_cast<const char*>(cached.get());
+        constexpr size_t ID_END = RESOURCE_MONITOR_ID_OFFSET + sizeof(uint32_t);
+
+        struct iovec iov[3];
+        iov[0].iov_base = const_cast<char*>(body);
+        iov[0].iov_len = RESOURCE_MONITOR_ID_OFFSET;
+        iov[1].iov_base = &responseID;
+        iov[1].iov_len = sizeof(responseID);
+        iov[2].iov_base = const_cast<char*>(body + ID_END);
+        iov[2].iov_len = sizeof(ResourceMonitorResponsePacket) - ID_END;
+
+        struct msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_name = const_cast<struct sockaddr_in*>(&senderAddr);
+        msg.msg_namelen = sizeof(senderAddr);
+        msg.msg_iov = iov;
+        msg.msg_iovlen = 3;
+
+        sendmsg(m_responseFd, &msg, 0);
+    }
+
+    /**
+     * @brief 处理任务查看报文请求（F005H）
+     * 
+     * 通过仓储的位置索引常数时间查找任务，以单播回复F105H。
+     * 位置无效或没有任务时回复异常状态，字段为0。
+     */
+    void HandleTaskViewRequest(const TaskViewRequestPacket* request,
+                               const struct sockaddr_in& senderAddr) {
+        if (!m_monitoringService || m_responseFd < 0) {
+            return;
+        }
+
+        TaskViewResponsePacket response;
+        response.responseID = request->requestID;  // 响应ID等于请求ID
+
+        auto slot = m_monitoringService->FindTaskAt(
+            request->chassisNumber, request->boardNumber, request->taskIndex);
+        if (slot.has_value()) {
+            const auto& view = slot.value();
+            
+            // 任务状态：0=正常，1=异常（与资源监控报文的正常判断一致）
+            bool normal = std::strcmp(view.taskStatus, "normal") == 0 ||
+                          std::strcmp(view.taskStatus, "running") == 0;
+            response.taskStatus = normal ? 0 : 1;
+            response.taskID = ParseTaskNumber(view.taskID);
+            
+            in_addr_t boardIP = inet_addr(view.boardAddress);
+            response.boardIP = (boardIP == INADDR_NONE) ? 0 : boardIP;
+            
+            if (view.hasResources) {
+                float permille = view.resources.cpuUsage * 10.0f;  // 百分比 -> 千分比
+                permille = std::min(std::max(permille, 0.0f), 1000.0f);
+                response.cpuUsage = static_cast<uint16_t>(permille + 0.5f);
+                response.memoryUsage = view.resources.memoryUsage;
+            }
+        }
+
+        sendto(m_responseFd, &response, sizeof(response), 0,
+               reinterpret_cast<const struct sockaddr*>(&senderAddr), sizeof(senderAddr));
+    }
+
+    /**
+     * @brief 将任务ID字符串转换为协议中的4字节任务ID
+     * 
+     * 取字符串末尾的连续数字（如"task-0042" -> 42），没有数字时返回0。
+     */
+    static uint32_t ParseTaskNumber(const char* taskID) {
+        size_t end = std::strlen(taskID);
+        size_t begin = end;
+        while (begin > 0 && taskID[begin - 1] >= '0' && taskID[begin - 1] <= '9') {
+            --begin;
+        }
+        
+        uint32_t number = 0;
+        for (size_t i = begin; i < end; ++i) {
+            number = number * 10 + static_cast<uint32_t>(taskID[i] - '0');
+        }
+        return number;
+    }
+
+    /**
+     * @brief 处理重传请求（NACK）
+     * 
+     * 对每个仍在重传环中的序列号，以单播重传原编码数据报（不重新编码）：
+     * 从环中拷贝出数据报（不在持有环的锁时发送），包头置PACKET_FLAG_RETRANSMIT。
+     * 不在环中的序列号忽略（前端等待下一轮广播）。
+     * 
+     * NACK没有认证，为避免被用作反射放大器（见RetransmitLimiter）：未配置允许网段时不重传，
+     * 不在允许网段的发送方直接丢弃；单次请求的重传字节数不超过请求大小的
+     * RETRANSMIT_AMPLIFICATION_LIMIT倍，且按发送方和全局限速，超出后本次请求剩余的序列号不再重传。
+     */
+    void HandleRetransmitRequest(const char* data, size_t dataLen,
+                                 const struct sockaddr_in& senderAddr) {
+        if (!m_retransmitRing || m_responseFd < 0) {
+            return;
+        }
+        if (!m_retransmitLimiter.AcceptRequest(senderAddr)) {
+            return;
+        }
+
+        uint32_t sequenceCount = 0;
+        std::memcpy(&sequenceCount, data + sizeof(UdpPacketHeader), sizeof(sequenceCount));
+        
+        // 只处理数据报中实际携带的序列号
+        size_t available = (dataLen - RETRANSMIT_REQUEST_PREFIX_SIZE) / sizeof(uint32_t);
+        size_t count = std::min<size_t>({sequenceCount, MAX_RETRANSMIT_SEQUENCES, available});
+
+        auto now = Clock::now();
+        size_t requestLimit = dataLen * RETRANSMIT_AMPLIFICATION_LIMIT;
+        size_t requestBytes = 0;
+        std::vector<char> packet;
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t sequenceNumber = 0;
+            std::memcpy(&sequenceNumber,
+                        data + RETRANSMIT_REQUEST_PREFIX_SIZE + i * sizeof(uint32_t),
+                        sizeof(sequenceNumber));
+
+            if (!m_retransmitRing->Find(sequenceNumber, packet)) {
+                continue;
+            }
+            if (!m_retransmitLimiter.Admit(senderAddr, packet.size(), requestBytes, requestLimit, now)) {
+                break;
+            }
+
+            auto* header = reinterpret_cast<UdpPacketHeader*>(packet.data());
+            header->reserved[0] |= PACKET_FLAG_RETRANSMIT;
+            SendDatagram(packet.data(), packet.size(), senderAddr);
+        }
+    }
+
+    /**
+     * @brief 处理部署业务链命令（异步执行）
+     */
+    void HandleDeployStack(const DeployStackCommand* cmd, const struct sockaddr_in& senderAddr,
+                           Clock::time_point receivedAt) {
+        CommandKey key = MakeCommandKey(senderAddr, PacketType::DeployStack, cmd->commandID);
+        if (!BeginCommand(key, senderAddr)) {
+            return;  // 重复命令，已回复
+        }
+
+        std::string labelUUID(cmd->labelUUID, strnlen(cmd->labelUUID, sizeof(cmd->labelUUID)));
         
-        // 构造DeployCommandDTO
-        application::DeployCommandDTO command;
-        command.stackLabels.push_back(labelUUID);
+        SubmitCommand(key, senderAddr, [this, key, senderAddr, labelUUID, receivedAt]() {
+            Clock::time_point dispatchedAt = Clock::now();
 
-        // 调用业务逻辑
-        auto response = m_stackControlService->DeployByLabels(command);
+            // 构造DeployCommandDTO
+            application::DeployCommandDTO command;
+            command.stackLabels.push_back(labelUUID);
 
-        // 发送响应
-        SendCommandResponse(
-            cmd->commandID,
-            static_cast<uint16_t>(PacketType::DeployStack),
-            response.success ? CommandResult::Success : CommandResult::Failed,
-            response.message
-        );
+            // 调用业务逻辑
+            auto response = m_stackControlService->DeployByLabels(command);
+            Clock::time_point returnedAt = Clock::now();
+
+            // 发送最终结果
+            FinishCommand(key, senderAddr,
+                          response.success ? CommandResult::Success : CommandResult::Failed,
+                          response.message);
+            RecordLatency(CommandMetric::DeployStack, receivedAt, dispatchedAt, returnedAt);
+        });
     }
 
     /**
-     * @brief 处理卸载业务链命令
+     * @brief 处理卸载业务链命令（异步执行）
      */
-    void HandleUndeployStack(const UndeployStackCommand* cmd) {
-        std::string labelUUID(cmd->labelUUID);
+    void HandleUndeployStack(const UndeployStackCommand* cmd, const struct sockaddr_in& senderAddr,
+                             Clock::time_point receivedAt) {
+        CommandKey key = MakeCommandKey(senderAddr, PacketType::UndeployStack, cmd->commandID);
+        if (!BeginCommand(key, senderAddr)) {
+            return;  // 重复命令，已回复
+        }
+
+        std::string labelUUID(cmd->labelUUID, strnlen(cmd->labelUUID, sizeof(cmd->labelUUID)));
         
-        // 构造DeployCommandDTO（Deploy和Undeploy共用同一个DTO）
-        application::DeployCommandDTO command;
-        command.stackLabels.push_back(labelUUID);
+        SubmitCommand(key, senderAddr, [this, key, senderAddr, labelUUID, receivedAt]() {
+            Clock::time_point dispatchedAt = Clock::now();
+
+            // 构造DeployCommandDTO（Deploy和Undeploy共用同一个DTO）
+            application::DeployCommandDTO command;
+            command.stackLabels.push_back(labelUUID);
+
+            // 调用业务逻辑
+            auto response = m_stackControlService->UndeployByLabels(command);
+            Clock::time_point returnedAt = Clock::now();
+
+            // 发送最终结果
+            FinishCommand(key, senderAddr,
+                          response.success ? CommandResult::Success : CommandResult::Failed,
+                          response.message);
+            RecordLatency(CommandMetric::UndeployStack, receivedAt, dispatchedAt, returnedAt);
+        });
+    }
+
+    /**
+     * @brief 命令类型所属的优先级通道
+     */
+    static CommandLane LaneOf(PacketType commandType) {
+        switch (commandType) {
+            case PacketType::DeployStack:
+            case PacketType::UndeployStack:
+            case PacketType::BatchCommand:      // 只含告警确认的批量命令由调用方指定交互通道
+                return CommandLane::Bulk;
+            case PacketType::AcknowledgeAlert:
+                return CommandLane::Interactive;
+            default:
+                return CommandLane::Inline;
+        }
+    }
 
-        // 调用业务逻辑
-        auto response = m_stackControlService->UndeployByLabels(command);
+    /**
+     * @brief 通道的执行线程池（Inline通道返回nullptr）
+     */
+    CommandExecutor* ExecutorFor(CommandLane lane) {
+        switch (lane) {
+            case CommandLane::Interactive:
+                return &m_interactiveExecutor;
+            case CommandLane::Bulk:
+                return &m_bulkExecutor;
+            default:
+                return nullptr;
+        }
+    }
 
-        // 发送响应
-        SendCommandResponse(
-            cmd->commandID,
-            static_cast<uint16_t>(PacketType::UndeployStack),
-            response.success ? CommandResult::Success : CommandResult::Failed,
-            response.message
-        );
+    /**
+     * @brief 将命令提交到所属通道的执行线程池
+     * 
+     * 批量通道入队成功后立即回复Accepted（最终结果由执行线程另行回复）；
+     * 交互通道执行很快，只回复最终结果。队列已满回复Busy
+     * 并撤销去重登记（前端重试时重新执行）。
+     * 监听器停止时仍在队列中的命令不执行，同样回复Busy并撤销去重登记。
+     */
+    void SubmitCommand(const CommandKey& key, const struct sockaddr_in& senderAddr,
+                       CommandExecutor::Task task) {
+        SubmitCommand(LaneOf(static_cast<PacketType>(key.commandType)), key, senderAddr, std::move(task));
     }
 
     /**
-     * @brief 处理确认告警命令
+     * @brief 将命令提交到指定通道的执行线程池
      */
-    void HandleAcknowledgeAlert(const AcknowledgeAlertCommand* cmd) {
-        std::string alertID(cmd->alertID);
+    void SubmitCommand(CommandLane lane, const CommandKey& key, const struct sockaddr_in& senderAddr,
+                       CommandExecutor::Task task) {
+        CommandExecutor* executor = ExecutorFor(lane);
+        if (!executor) {
+            task();  // Inline通道直接执行
+            return;
+        }
+
+        auto onDiscard = [this, key, senderAddr]() {
+            m_dedupCache.Abandon(key);
+            SendCommandResponse(key, senderAddr,
+                                CommandResult::Busy, "服务正在停止，命令未执行，请稍后重试");
+        };
+        if (executor->TrySubmit(std::move(task), std::move(onDiscard))) {
+            if (lane == CommandLane::Bulk) {
+                SendCommandResponse(key, senderAddr, CommandResult::Accepted, "命令已受理");
+            }
+        } else {
+            m_dedupCache.Abandon(key);
+            SendCommandResponse(key, senderAddr,
+                                CommandResult::Busy, "服务繁忙，命令未执行，请稍后重试");
+        }
+    }
+
+    /**
+     * @brief 处理确认告警命令（交互通道执行）
+     */
+    void HandleAcknowledgeAlert(const AcknowledgeAlertCommand* cmd, const struct sockaddr_in& senderAddr,
+                                Clock::time_point receivedAt) {
+        CommandKey key = MakeCommandKey(senderAddr, PacketType::AcknowledgeAlert, cmd->commandID);
+        if (!BeginCommand(key, senderAddr)) {
+            return;  // 重复命令，已回复（不再获取告警仓储写锁）
+        }
+
+        std::string alertID(cmd->alertID, strnlen(cmd->alertID, sizeof(cmd->alertID)));
         // operatorID 可用于日志记录，但AlertService::AcknowledgeAlert不需要此参数
 
-        // 调用业务逻辑
-        auto response = m_alertService->AcknowledgeAlert(alertID);
+        SubmitCommand(key, senderAddr, [this, key, senderAddr, alertID, receivedAt]() {
+            Clock::time_point dispatchedAt = Clock::now();
+
+            // 调用业务逻辑
+            auto response = m_alertService->AcknowledgeAlert(alertID);
+            Clock::time_point returnedAt = Clock::now();
 
-        // 发送响应
-        SendCommandResponse(
-            cmd->commandID,
-            static_cast<uint16_t>(PacketType::AcknowledgeAlert),
-            response.success ? CommandResult::Success : CommandResult::Failed,
-            response.message
-        );
+            // 发送响应
+            FinishCommand(key, senderAddr,
+                          response.success ? CommandResult::Success : CommandResult::Failed,
+                          response.message);
+            RecordLatency(CommandMetric::AcknowledgeAlert, receivedAt, dispatchedAt, returnedAt);
+        });
     }
 
     /**
-     * @brief 发送命令响应
+     * @brief 处理批量命令
+     * 
+     * 先完整解析所有子命令（格式错误时回复InvalidParameter，不执行任何子命令），再一次执行：
+     * 告警确认一次批量确认（一次写锁），部署/卸载各一次后端调用，回复一个逐项结果响应。
+     * 只含告警确认时走交互通道，含部署/卸载时走批量通道（先回复Accepted）。
+     */
+    void HandleBatchCommand(const char* data, size_t dataLen, const struct sockaddr_in& senderAddr,
+                            Clock::time_point receivedAt) {
+        BatchCommandHeader batch;
+        std::memcpy(&batch, data, sizeof(batch));
+        CommandKey key = MakeCommandKey(senderAddr, PacketType::BatchCommand, batch.commandID);
+
+        std::vector<BatchItem> items;
+        if (!ParseBatchItems(data, dataLen, batch.itemCount, items)) {
+            SendCommandResponse(key, senderAddr, CommandResult::InvalidParameter, "批量命令格式错误");
+            return;
+        }
+
+        if (!BeginCommand(key, senderAddr)) {
+            return;  // 重复命令，已回复
+        }
+
+        bool ackOnly = std::all_of(items.begin(), items.end(), [](const BatchItem& item) {
+            return item.itemType != static_cast<uint8_t>(BatchItemType::DeployStack) &&
+                   item.itemType != static_cast<uint8_t>(BatchItemType::UndeployStack);
+        });
+        CommandLane lane = ackOnly ? CommandLane::Interactive : CommandLane::Bulk;
+
+        SubmitCommand(lane, key, senderAddr, [this, key, senderAddr, items = std::move(items), receivedAt]() {
+            Clock::time_point dispatchedAt = Clock::now();
+
+            // 一次执行全部子命令
+            std::vector<uint8_t> results = ExecuteBatch(items);
+            Clock::time_point returnedAt = Clock::now();
+
+            // 发送逐项结果
+            FinishBatch(key, senderAddr, results);
+            RecordLatency(CommandMetric::BatchCommand, receivedAt, dispatchedAt, returnedAt);
+        });
+    }
+
+    /**
+     * @brief 解析批量命令的子命令
+     * 
+     * @return false 如果子命令数量无效或数据报被截断
+     */
+    static bool ParseBatchItems(const char* data, size_t dataLen, uint16_t itemCount,
+                                std::vector<BatchItem>& items) {
+        if (itemCount == 0 || itemCount > MAX_BATCH_ITEMS) {
+            return false;
+        }
+
+        items.reserve(itemCount);
+        size_t offset = sizeof(BatchCommandHeader);
+        for (uint16_t i = 0; i < itemCount; ++i) {
+            if (offset + 2 > dataLen) {
+                return false;
+            }
+            uint8_t itemType = static_cast<uint8_t>(data[offset]);
+            size_t idLength = static_cast<uint8_t>(data[offset + 1]);
+            offset += 2;
+            if (idLength == 0 || idLength > MAX_BATCH_ITEM_ID_LENGTH || offset + idLength > dataLen) {
+                return false;
+            }
+            items.push_back({itemType, std::string(data + offset, idLength)});
+            offset += idLength;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 执行批量子命令
+     * 
+     * @return 与子命令一一对应的结果（CommandResult）
+     */
+    std::vector<uint8_t> ExecuteBatch(const std::vector<BatchItem>& items) {
+        std::vector<uint8_t> results(items.size(), static_cast<uint8_t>(CommandResult::InvalidParameter));
+
+        // 按类型分组（记录子命令序号，结果按序号写回）
+        application::AlertAcknowledgeDTO acknowledge;
+        std::vector<std::string> deployLabels, undeployLabels;
+        std::vector<size_t> acknowledgeIndex, deployIndex, undeployIndex;
+        for (size_t i = 0; i < items.size(); ++i) {
+            switch (static_cast<BatchItemType>(items[i].itemType)) {
+                case BatchItemType::AcknowledgeAlert:
+                    acknowledge.alertUUIDs.push_back(items[i].targetID);
+                    acknowledgeIndex.push_back(i);
+                    break;
+                case BatchItemType::DeployStack:
+                    deployLabels.push_back(items[i].targetID);
+                    deployIndex.push_back(i);
+                    break;
+                case BatchItemType::UndeployStack:
+                    undeployLabels.push_back(items[i].targetID);
+                    undeployIndex.push_back(i);
+                    break;
+                default:
+                    break;  // 未知子命令类型：InvalidParameter
+            }
+        }
+
+        // 告警确认：一次仓储调用
+        if (!acknowledgeIndex.empty()) {
+            auto response = m_alertService->AcknowledgeEach(acknowledge);
+            for (size_t k = 0; k < acknowledgeIndex.size(); ++k) {
+                CommandResult result = CommandResult::Failed;
+                if (response.success && k < response.data.size()) {
+                    result = response.data[k] ? CommandResult::Success : CommandResult::NotFound;
+                }
+                results[acknowledgeIndex[k]] = static_cast<uint8_t>(result);
+            }
+        }
+
+        // 部署/卸载：各一次后端调用，按标签拆分结果（每项只看本标签下的业务链路）
+        auto applyDeployResults = [&results](const std::vector<size_t>& index,
+                                             const std::vector<application::ResponseDTO<application::DeployResultDTO>>& responses) {
+            for (size_t k = 0; k < index.size() && k < responses.size(); ++k) {
+                const auto& response = responses[k];
+                CommandResult result = CommandResult::Failed;
+                if (response.success && !response.data.attributed) {
+                    result = CommandResult::Unattributed;
+                } else if (response.success && response.data.failureCount == 0) {
+                    result = CommandResult::Success;
+                }
+                results[index[k]] = static_cast<uint8_t>(result);
+            }
+        };
+        if (!deployIndex.empty()) {
+            applyDeployResults(deployIndex, m_stackControlService->DeployEachLabel(deployLabels));
+        }
+        if (!undeployIndex.empty()) {
+            applyDeployResults(undeployIndex, m_stackControlService->UndeployEachLabel(undeployLabels));
+        }
+
+        return results;
+    }
+
+    /**
+     * @brief 发送批量命令的逐项结果，并缓存供重复请求使用
+     */
+    void FinishBatch(const CommandKey& key, const struct sockaddr_in& senderAddr,
+                     const std::vector<uint8_t>& results) {
+        BatchCommandResponseHeader response;
+        response.header.timestamp = GetCurrentTimestampMs();
+        response.header.dataLength = static_cast<uint32_t>(
+            sizeof(response) - sizeof(UdpPacketHeader) + results.size());
+        response.commandID = key.commandID;
+        response.itemCount = static_cast<uint16_t>(results.size());
+        response.successCount = static_cast<uint16_t>(std::count(
+            results.begin(), results.end(), static_cast<uint8_t>(CommandResult::Success)));
+        response.result = static_cast<uint16_t>(
+            response.successCount == response.itemCount ? CommandResult::Success : CommandResult::Failed);
+
+        std::vector<char> packet(sizeof(response) + results.size());
+        std::memcpy(packet.data(), &response, sizeof(response));
+        std::memcpy(packet.data() + sizeof(response), results.data(), results.size());
+        Deliver(key, senderAddr, packet.data(), packet.size());
+    }
+
+    /**
+     * @brief 构造命令去重键
+     */
+    static CommandKey MakeCommandKey(const struct sockaddr_in& senderAddr,
+                                     PacketType commandType, uint64_t commandID) {
+        CommandKey key;
+        key.senderIP = senderAddr.sin_addr.s_addr;
+        key.commandType = static_cast<uint16_t>(commandType);
+        key.commandID = commandID;
+        return key;
+    }
+
+    /**
+     * @brief 登记命令并处理重复请求
+     * 
+     * - 已完成的重复命令：重发缓存的最终响应
+     * - 执行中的重复命令：回复Accepted，不重复执行（最终结果完成时同样发给重发方）
+     * - 去重记录已满且都在执行中：回复Busy，不执行（前端稍后重试）
+     * 
+     * @return true 如果是首次到达的命令，调用方应执行
+     */
+    bool BeginCommand(const CommandKey& key, const struct sockaddr_in& senderAddr) {
+        std::vector<char> cached;
+        switch (m_dedupCache.Begin(key, senderAddr, cached)) {
+            case CommandDedupCache::State::New:
+                return true;
+
+            case CommandDedupCache::State::Completed:
+                if (cached.size() >= sizeof(UdpPacketHeader)) {
+                    uint64_t timestamp = GetCurrentTimestampMs();
+                    std::memcpy(cached.data() + offsetof(UdpPacketHeader, timestamp),
+                                &timestamp, sizeof(timestamp));
+                    SendDatagram(cached.data(), cached.size(), senderAddr);
+                }
+                return false;
+
+            case CommandDedupCache::State::Busy:
+                SendCommandResponse(key, senderAddr,
+                                    CommandResult::Busy, "服务繁忙，命令未执行，请稍后重试");
+                return false;
+
+            case CommandDedupCache::State::InFlight:
+            default:
+                SendCommandResponse(key, senderAddr, CommandResult::Accepted, "命令执行中");
+                return false;
+        }
+    }
+
+    /**
+     * @brief 发送命令的最终结果，并缓存供重复请求使用
+     */
+    void FinishCommand(const CommandKey& key, const struct sockaddr_in& senderAddr,
+                       CommandResult result, const std::string& message) {
+        CommandResponsePacket response = MakeCommandResponse(key.commandID, key.commandType,
+                                                             result, message);
+        Deliver(key, senderAddr, reinterpret_cast<const char*>(&response), sizeof(response));
+    }
+
+    /**
+     * @brief 投递最终响应数据报
+     * 
+     * 缓存供重复请求使用；以单播回复原发送方，以及执行期间从其他端口重发该命令的地址；
+     * 开启审计回显时再向多播组发送一份。
+     */
+    void Deliver(const CommandKey& key, const struct sockaddr_in& senderAddr,
+                 const char* packet, size_t length) {
+        auto waiters = m_dedupCache.Complete(key, packet, length);
+        SendDatagram(packet, length, senderAddr);
+        for (const auto& waiter : waiters) {
+            SendDatagram(packet, length, waiter);
+        }
+
+        if (m_auditEcho.load(std::memory_order_relaxed)) {
+            SendDatagram(packet, length, m_responseAddr);
+        }
+    }
+
+    /**
+     * @brief 以单播向命令发送方回复
      */
     void SendCommandResponse(
-        uint64_t commandID,
-        uint16_t originalCommandType,
+        const CommandKey& key,
+        const struct sockaddr_in& senderAddr,
         CommandResult result,
         const std::string& message) {
         
-        if (m_responseFd < 0) {
-            return;
-        }
+        CommandResponsePacket response = MakeCommandResponse(key.commandID, key.commandType,
+                                                             result, message);
+        SendDatagram(reinterpret_cast<const char*>(&response), sizeof(response), senderAddr);
+    }
 
+    /**
+     * @brief 构造命令响应包
+     */
+    CommandResponsePacket MakeCommandResponse(
+        uint64_t commandID,
+        uint16_t originalCommandType,
+        CommandResult result,
+        const std::string& message) const {
+        
         CommandResponsePacket response;
         response.header.timestamp = GetCurrentTimestampMs();
         response.commandID = commandID;
         response.originalCommandType = originalCommandType;
         response.result = static_cast<uint16_t>(result);
         std::strncpy(response.message, message.c_str(), sizeof(response.message) - 1);
+        return response;
+    }
 
-        sendto(m_responseFd, &response, sizeof(response), 0,
-               (struct sockaddr*)&m_responseAddr,
-               sizeof(m_responseAddr));
+    /**
+     * @brief 发送响应数据报
+     * 
+     * @param destination 目标地址（命令发送方，或审计回显的多播组）
+     */
+    void SendDatagram(const char* packet, size_t length, const struct sockaddr_in& destination) {
+        if (m_responseFd < 0) {
+            return;
+        }
+
+        sendto(m_responseFd, packet, length, 0,
+               reinterpret_cast<const struct sockaddr*>(&destination),
+               sizeof(destination));
     }
 
     /**
@@ -323,15 +1252,31 @@ class CommandListener {
     // 依赖服务
     std::shared_ptr<application::StackControlService> m_stackControlService;
     std::shared_ptr<application::AlertService> m_alertService;
+    std::shared_ptr<ResourceMonitorCache> m_resourceMonitorCache;  // F000H回复复用的编码缓存
+    std::shared_ptr<application::MonitoringService> m_monitoringService;  // F005H任务查看
+    std::shared_ptr<RetransmitRing> m_retransmitRing;                     // NACK重传
+    RetransmitLimiter m_retransmitLimiter;                                 // NACK发送方过滤和限速
     
     // 运行状态
     std::atomic<bool> m_running;            // 是否正在运行
-    std::thread m_listenerThread;           // 监听线程
+    CommandExecutor m_interactiveExecutor{1, 256};  // 交互通道：确认告警
+    CommandExecutor m_bulkExecutor;                 // 批量通道：部署/卸载
+    CommandDedupCache m_dedupCache;         // 重发命令去重（发送方 + 命令ID -> 最终响应）
+    
+    // 延迟统计
+    std::array<CommandLatency, static_cast<size_t>(CommandMetric::Count)> m_latency;
+    infrastructure::SloMonitor m_slo{"CommandListener"};   // 命令响应时间SLO
     
     // 网络相关
-    int m_socketFd;                         // 接收socket文件描述符
+    std::vector<std::unique_ptr<Shard>> m_shards;   // 接收分片（增删和统计读取持有m_shardsMutex；
+                                                    // 监听线程运行期间不增删，无锁访问）
+    mutable std::mutex m_shardsMutex;
+    UdpReceiveStats m_closedShardStats;     // 已关闭分片的接收统计
+    size_t m_shardCount = 1;                // 分片数
     int m_responseFd;                       // 响应socket文件描述符
-    struct sockaddr_in m_responseAddr;      // 响应目标地址
+    int m_receiveBufferBytes = 0;           // 接收socket的SO_RCVBUF（0表示系统默认）
+    struct sockaddr_in m_responseAddr;      // 审计回显的多播地址
+    std::atomic<bool> m_auditEcho{false};   // 最终结果是否同时多播回显
 };
 
 } // namespace zygl::interfaces
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "udp_protocol.h"
+#include <cstring>
+#include <vector>
+
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+#include <zlib.h>
+#endif
+
+namespace zygl::interfaces {
+
+/**
+ * @brief PayloadCompressor - 广播数据报载荷压缩（zlib）
+ * 
+ * 压缩格式（UdpPacketHeader.reserved[0]置PACKET_FLAG_COMPRESSED）：
+ * - 包头不压缩（序列号、时间戳可以在重发时直接修改）
+ * - 包头之后：uint32_t 原始载荷长度 + zlib数据流
+ * - header.dataLength为压缩后包头之后的字节数
+ * 
+ * 压缩结果不小于原始载荷时保持原样发送（不置标志）。
+ * 仅在以CPPHTTPLIB_ZLIB_SUPPORT编译（make ZLIB=1 / cmake -DENABLE_ZLIB=ON）时可用，
+ * 否则CompressInPlace()总是返回false。
+ * 
+ * 线程安全：
+ * - 非线程安全（内部复用压缩缓冲区），由单一编码线程使用
+ */
+class PayloadCompressor {
+public:
+    /**
+     * @brief 是否编译了zlib支持
+     */
+    static constexpr bool IsAvailable() {
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 原地压缩一个带UdpPacketHeader的数据报
+     * 
+     * @param datagram 数据报缓冲区（容量MAX_UDP_PAYLOAD）
+     * @param length 数据报长度，压缩成功时更新为压缩后的长度
+     * @return true 如果已压缩，false 如果保持原样
+     */
+    bool CompressInPlace(char* datagram, size_t& length) {
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+        if (length <= sizeof(UdpPacketHeader) + sizeof(uint32_t)) {
+            return false;
+        }
+
+        char* body = datagram + sizeof(UdpPacketHeader);
+        const size_t bodyLength = length - sizeof(UdpPacketHeader);
+
+        uLongf compressedLength = compressBound(static_cast<uLong>(bodyLength));
+        if (m_buffer.size() < compressedLength) {
+            m_buffer.resize(compressedLength);
+        }
+        if (compress2(m_buffer.data(), &compressedLength,
+                      reinterpret_cast<const Bytef*>(body), static_cast<uLong>(bodyLength),
+                      Z_DEFAULT_COMPRESSION) != Z_OK) {
+            return false;
+        }
+
+        // 压缩后（含4字节原始长度）不更小则回退为不压缩
+        const size_t newBodyLength = sizeof(uint32_t) + compressedLength;
+        if (newBodyLength >= bodyLength) {
+            return false;
+        }
+
+        uint32_t rawLength = static_cast<uint32_t>(bodyLength);
+        std::memcpy(body, &rawLength, sizeof(rawLength));
+        std::memcpy(body + sizeof(rawLength), m_buffer.data(), compressedLength);
+
+        auto* header = reinterpret_cast<UdpPacketHeader*>(datagram);
+        header->reserved[0] = static_cast<char>(header->reserved[0] | PACKET_FLAG_COMPRESSED);
+        header->dataLength = static_cast<uint32_t>(newBodyLength);
+        length = sizeof(UdpPacketHeader) + newBodyLength;
+        return true;
+#else
+        (void)datagram;
+        (void)length;
+        return false;
+#endif
+    }
+
+private:
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+    std::vector<Bytef> m_buffer;    // 压缩输出缓冲区（复用）
+#endif
+};
+
+} // namespace zygl::interfaces
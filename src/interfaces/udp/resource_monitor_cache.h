@@ -0,0 +1,153 @@
+#pragma once
+
+#include "udp_protocol.h"
+#include "../../application/services/monitoring_service.h"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace zygl::interfaces {
+
+/**
+ * @brief ResourceMonitorCache - 资源监控报文（F000H）编码缓存
+ * 
+ * 职责：
+ * 1. 按机箱快照版本号缓存编码好的ResourceMonitorResponsePacket
+ * 2. 版本号不变时直接返回缓存，版本号变化时重新编码一次
+ * 
+ * 使用者：
+ * - StateBroadcaster：周期/事件触发的多播广播
+ * - CommandListener：前端F000H请求的单播回复
+ * 
+ * 缓存中的responseID始终为0，由使用者在发送时填写。
+ * 
+ * 线程安全：
+ * - GetPacket()可以被多个线程并发调用，同一版本只编码一次
+ * - 返回的报文不可变，可以在锁外使用
+ */
+class ResourceMonitorCache {
+public:
+    using PacketPtr = std::shared_ptr<const ResourceMonitorResponsePacket>;
+
+    /**
+     * @brief 构造函数
+     * 
+     * @param monitoringService 监控服务（用于获取系统状态和快照版本号）
+     */
+    explicit ResourceMonitorCache(
+        std::shared_ptr<application::MonitoringService> monitoringService)
+        : m_monitoringService(monitoringService) {
+    }
+
+    // 禁止拷贝
+    ResourceMonitorCache(const ResourceMonitorCache&) = delete;
+    ResourceMonitorCache& operator=(const ResourceMonitorCache&) = delete;
+
+    /**
+     * @brief 获取当前快照对应的编码报文
+     * 
+     * @return 编码好的报文，获取系统状态失败且无缓存时返回nullptr
+     */
+    PacketPtr GetPacket() {
+        // 先读版本号再读数据：数据可能比版本号新，但不会比版本号旧
+        uint64_t version = m_monitoringService->GetChassisSnapshotVersion();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_packet && m_version == version) {
+            m_hits++;
+            return m_packet;
+        }
+
+        auto packet = Encode();
+        if (!packet) {
+            return m_packet;  // 失败时继续使用旧快照
+        }
+
+        m_packet = std::move(packet);
+        m_version = version;
+        m_encodes++;
+        return m_packet;
+    }
+
+    /**
+     * @brief 获取编码次数（版本变化次数）
+     */
+    uint64_t GetEncodeCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_encodes;
+    }
+
+    /**
+     * @brief 获取缓存命中次数
+     */
+    uint64_t GetHitCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_hits;
+    }
+
+private:
+    /**
+     * @brief 按资源监控报文响应协议编码所有机箱状态
+     */
+    std::shared_ptr<ResourceMonitorResponsePacket> Encode() const {
+        // 获取系统概览
+        auto response = m_monitoringService->GetSystemOverview();
+        if (!response.success) {
+            return nullptr;
+        }
+
+        // 构造函数已清零，默认状态为异常/离线
+        auto packet = std::make_shared<ResourceMonitorResponsePacket>();
+        
+        // 遍历所有机箱，填充板卡和任务状态
+        for (const auto& chassisDTO : response.data.chassis) {
+            int32_t chassisIndex = chassisDTO.chassisNumber - 1;  // 机箱号1-9转换为索引0-8
+            
+            // 检查机箱号是否有效
+            if (chassisIndex < 0 || chassisIndex >= 9) {
+                continue;
+            }
+            
+            // 填充板卡状态（12块板卡）
+            for (size_t boardIdx = 0; boardIdx < chassisDTO.boards.size() && boardIdx < 12; ++boardIdx) {
+                const auto& boardDTO = chassisDTO.boards[boardIdx];
+                
+                // 板卡状态：1=正常，0=异常
+                // boardStatus: -1=未知，0=正常，1=异常，2=离线
+                if (boardDTO.boardStatus == 0) {
+                    packet->boardStates[chassisIndex][boardIdx] = 1;  // 正常
+                } else {
+                    packet->boardStates[chassisIndex][boardIdx] = 0;  // 异常或离线
+                }
+                
+                // 填充任务状态（每个板卡最多8个任务）
+                for (size_t taskIdx = 0; taskIdx < boardDTO.taskStatuses.size() && taskIdx < 8; ++taskIdx) {
+                    const std::string& status = boardDTO.taskStatuses[taskIdx];
+                    
+                    // 任务状态：1=正常，2=异常
+                    // 根据任务状态字符串判断
+                    if (status.empty() || status == "unknown") {
+                        packet->taskStates[chassisIndex][boardIdx][taskIdx] = 0;  // 未知
+                    } else if (status == "normal" || status == "running") {
+                        packet->taskStates[chassisIndex][boardIdx][taskIdx] = 1;  // 正常
+                    } else {
+                        packet->taskStates[chassisIndex][boardIdx][taskIdx] = 2;  // 异常
+                    }
+                }
+            }
+        }
+
+        return packet;
+    }
+
+private:
+    std::shared_ptr<application::MonitoringService> m_monitoringService;
+
+    mutable std::mutex m_mutex;     // 保护以下字段
+    PacketPtr m_packet;             // 当前缓存的报文
+    uint64_t m_version = 0;         // 缓存对应的快照版本号
+    uint64_t m_encodes = 0;         // 编码次数
+    uint64_t m_hits = 0;            // 命中次数
+};
+
+} // namespace zygl::interfaces
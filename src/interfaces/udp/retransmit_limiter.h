@@ -0,0 +1,234 @@
+#pragma once
+
+#include "token_bucket_pacer.h"
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace zygl::interfaces {
+
+/**
+ * @brief 重传限制统计快照
+ */
+struct RetransmitLimiterStats {
+    uint64_t requests = 0;          // 收到的重传请求数
+    uint64_t rejectedRequests = 0;  // 未启用重传或发送方不在允许网段而丢弃的请求数
+    uint64_t sentPackets = 0;       // 重传的数据报数
+    uint64_t sentBytes = 0;         // 重传的字节数
+    uint64_t throttledPackets = 0;  // 因单次请求字节上限、发送方或全局限速而未重传的数据报数
+    size_t senders = 0;             // 当前跟踪的发送方数
+};
+
+/**
+ * @brief RetransmitLimiter - 重传请求（NACK）的发送方过滤和限速
+ *
+ * NACK没有认证，一个几百字节的请求可以触发几十个大数据报发往请求中的源地址，
+ * 伪造源地址即可把本服务变成反射放大器。限制分四层：
+ * - 网段过滤：只响应允许网段（前端所在网段）内的发送方；未配置网段时不响应任何NACK（默认关闭）
+ * - 单次请求上限：重传字节数不超过调用方给出的上限（请求大小的固定倍数），且不超过MAX_BYTES_PER_REQUEST
+ * - 发送方限速：每个发送方IP一个令牌桶（TokenBucketPacer），超出速率的数据报不重传
+ * - 全局限速：所有发送方共享一个令牌桶，伪造大量源地址也无法超出总速率
+ *
+ * 未重传的序列号由前端等待下一轮广播，或稍后再次NACK。
+ * 跟踪的发送方数有上限，满时先清理空闲的发送方，仍满则不为新发送方重传。
+ *
+ * 线程安全：
+ * - 所有方法都可以被多个接收分片线程并发调用
+ */
+class RetransmitLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t MAX_BYTES_PER_REQUEST = 256 * 1024;     // 单次请求最多重传的字节数
+    static constexpr size_t MAX_TRACKED_SENDERS = 1024;             // 跟踪的发送方数上限
+    static constexpr uint32_t DEFAULT_PACKETS_PER_SECOND = 200;     // 默认每个发送方每秒重传数据报数
+    static constexpr uint64_t DEFAULT_BYTES_PER_SECOND = 2 * 1024 * 1024;  // 默认每个发送方每秒重传字节数
+    static constexpr uint32_t DEFAULT_TOTAL_PACKETS_PER_SECOND = 1000;       // 默认全局每秒重传数据报数
+    static constexpr uint64_t DEFAULT_TOTAL_BYTES_PER_SECOND = 8 * 1024 * 1024;  // 默认全局每秒重传字节数
+
+    RetransmitLimiter() {
+        m_totalPacer.Configure(DEFAULT_TOTAL_PACKETS_PER_SECOND, DEFAULT_TOTAL_BYTES_PER_SECOND, BURST_SECONDS);
+    }
+
+    // 禁止拷贝
+    RetransmitLimiter(const RetransmitLimiter&) = delete;
+    RetransmitLimiter& operator=(const RetransmitLimiter&) = delete;
+
+    /**
+     * @brief 设置允许发送NACK的网段
+     *
+     * @param cidr 如"192.168.1.0/24"，空字符串表示禁用重传（"0.0.0.0/0"表示不限制网段）
+     * @return false 如果格式无效（保持原设置）
+     */
+    bool SetAllowedSubnet(const std::string& cidr) {
+        if (cidr.empty()) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_enabled = false;
+            return true;
+        }
+
+        size_t slash = cidr.find('/');
+        std::string address = cidr.substr(0, slash);
+        int prefix = 32;
+        if (slash != std::string::npos) {
+            try {
+                prefix = std::stoi(cidr.substr(slash + 1));
+            } catch (const std::exception&) {
+                prefix = -1;
+            }
+        }
+        struct in_addr parsed;
+        if (prefix < 0 || prefix > 32 || inet_pton(AF_INET, address.c_str(), &parsed) != 1) {
+            std::cerr << "RetransmitLimiter: 无效的网段 " << cidr << std::endl;
+            return false;
+        }
+
+        uint32_t mask = prefix == 0 ? 0 : ~0u << (32 - prefix);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_enabled = true;
+        m_subnetMask = mask;
+        m_subnetAddress = ntohl(parsed.s_addr) & mask;
+        return true;
+    }
+
+    /**
+     * @brief 设置每个发送方的重传速率（0表示不限制该维度）
+     */
+    void SetSenderRate(uint32_t packetsPerSecond, uint64_t bytesPerSecond) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_packetsPerSecond = packetsPerSecond;
+        m_bytesPerSecond = bytesPerSecond;
+        m_senders.clear();
+    }
+
+    /**
+     * @brief 设置所有发送方合计的重传速率（0表示不限制该维度）
+     */
+    void SetTotalRate(uint32_t packetsPerSecond, uint64_t bytesPerSecond) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_totalPacer.Configure(packetsPerSecond, bytesPerSecond, BURST_SECONDS);
+    }
+
+    /**
+     * @brief 登记一个重传请求，检查是否启用重传、发送方是否在允许网段
+     *
+     * @return false 如果应丢弃该请求
+     */
+    bool AcceptRequest(const struct sockaddr_in& sender) {
+        m_requests.fetch_add(1, std::memory_order_relaxed);
+        uint32_t address = ntohl(sender.sin_addr.s_addr);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_enabled || (address & m_subnetMask) != m_subnetAddress) {
+            m_rejectedRequests.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 判断能否向发送方重传一个数据报，可以时扣除发送方和全局的令牌
+     *
+     * @param requestBytes 本次请求已重传的字节数（放行时累加）
+     * @param requestLimit 本次请求最多重传的字节数（另受MAX_BYTES_PER_REQUEST限制）
+     * @return false 如果超出单次请求上限、发送方或全局速率
+     */
+    bool Admit(const struct sockaddr_in& sender, size_t length, size_t& requestBytes, size_t requestLimit,
+               Clock::time_point now) {
+        size_t limit = std::min(requestLimit, MAX_BYTES_PER_REQUEST);
+        if (requestBytes + length > limit || !AdmitSender(sender.sin_addr.s_addr, length, now)) {
+            m_throttledPackets.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        requestBytes += length;
+        m_sentPackets.fetch_add(1, std::memory_order_relaxed);
+        m_sentBytes.fetch_add(length, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief 获取统计快照
+     */
+    RetransmitLimiterStats GetStats() const {
+        RetransmitLimiterStats stats;
+        stats.requests = m_requests.load(std::memory_order_relaxed);
+        stats.rejectedRequests = m_rejectedRequests.load(std::memory_order_relaxed);
+        stats.sentPackets = m_sentPackets.load(std::memory_order_relaxed);
+        stats.sentBytes = m_sentBytes.load(std::memory_order_relaxed);
+        stats.throttledPackets = m_throttledPackets.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        stats.senders = m_senders.size();
+        return stats;
+    }
+
+private:
+    struct Sender {
+        TokenBucketPacer pacer;
+        Clock::time_point lastUsed;
+    };
+
+    static constexpr double BURST_SECONDS = 0.25;               // 令牌桶容量对应的突发时长（一次NACK可突发的量）
+    static constexpr auto SENDER_IDLE_TIMEOUT = std::chrono::seconds(10);   // 空闲多久后可以清理
+
+    /**
+     * @brief 发送方和全局令牌桶都足够时才扣除（全局令牌桶先检查、后扣除）
+     */
+    bool AdmitSender(uint32_t address, size_t length, Clock::time_point now) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_totalPacer.NextReadyTime(length, now) > now) {
+            return false;
+        }
+        if (m_packetsPerSecond == 0 && m_bytesPerSecond == 0) {
+            return m_totalPacer.AdmitOne(length, now);
+        }
+
+        auto it = m_senders.find(address);
+        if (it == m_senders.end()) {
+            if (m_senders.size() >= MAX_TRACKED_SENDERS) {
+                RemoveIdleSenders(now);
+                if (m_senders.size() >= MAX_TRACKED_SENDERS) {
+                    return false;
+                }
+            }
+            it = m_senders.emplace(address, Sender()).first;
+            it->second.pacer.Configure(m_packetsPerSecond, m_bytesPerSecond, BURST_SECONDS);
+        }
+        it->second.lastUsed = now;
+        return it->second.pacer.AdmitOne(length, now) && m_totalPacer.AdmitOne(length, now);
+    }
+
+    /**
+     * @brief 清理空闲的发送方（调用方持有锁；空闲超过超时的令牌桶已回满，删除不放宽限速）
+     */
+    void RemoveIdleSenders(Clock::time_point now) {
+        for (auto it = m_senders.begin(); it != m_senders.end();) {
+            if (now - it->second.lastUsed >= SENDER_IDLE_TIMEOUT) {
+                it = m_senders.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    bool m_enabled = false;                 // 是否已配置允许网段（未配置时不重传）
+    uint32_t m_subnetAddress = 0;           // 允许的网段（主机字节序，已按掩码截断）
+    uint32_t m_subnetMask = 0;              // 网段掩码（0表示不限制）
+    uint32_t m_packetsPerSecond = DEFAULT_PACKETS_PER_SECOND;
+    uint64_t m_bytesPerSecond = DEFAULT_BYTES_PER_SECOND;
+    std::unordered_map<uint32_t, Sender> m_senders;     // 发送方IP（网络字节序） -> 令牌桶
+    TokenBucketPacer m_totalPacer;                      // 所有发送方合计的令牌桶
+
+    std::atomic<uint64_t> m_requests{0};
+    std::atomic<uint64_t> m_rejectedRequests{0};
+    std::atomic<uint64_t> m_sentPackets{0};
+    std::atomic<uint64_t> m_sentBytes{0};
+    std::atomic<uint64_t> m_throttledPackets{0};
+};
+
+} // namespace zygl::interfaces
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "udp_protocol.h"
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace zygl::interfaces {
+
+/**
+ * @brief 重传环统计快照
+ */
+struct RetransmitStats {
+    uint64_t packetsStored = 0;         // 写入环的数据报数
+    uint64_t retransmitted = 0;         // 命中并重传的数据报数
+    uint64_t misses = 0;                // 已被覆盖或从未发送的序列号请求数
+};
+
+/**
+ * @brief RetransmitRing - 最近发送数据报的重传环
+ *
+ * 按序列号保存最近发送的已编码数据报（告警/标签包，含UdpPacketHeader），
+ * 槽位 = 序列号 % 容量。新数据报覆盖同一槽位的旧数据报，环满后最旧的数据报自然失效。
+ * 槽位缓冲区在首次写入时分配并在之后复用，稳态下无动态内存分配。
+ *
+ * 前端通过RetransmitRequest（NACK）命令请求重传，CommandListener从环中拷贝出
+ * 原始编码结果以单播回复，不重新编码。
+ *
+ * 线程安全：
+ * - Store()由广播线程调用（写锁）
+ * - Find()由命令监听线程调用（读锁），可以并发
+ */
+class RetransmitRing {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;     // 默认保存最近256个数据报
+
+    /**
+     * @brief 构造函数
+     *
+     * @param capacity 环容量（数据报数），0时使用默认值
+     */
+    explicit RetransmitRing(size_t capacity = DEFAULT_CAPACITY)
+        : m_slots(capacity > 0 ? capacity : DEFAULT_CAPACITY) {
+    }
+
+    // 禁止拷贝
+    RetransmitRing(const RetransmitRing&) = delete;
+    RetransmitRing& operator=(const RetransmitRing&) = delete;
+
+    /**
+     * @brief 保存一个已发送的数据报
+     *
+     * @param data 数据报（以UdpPacketHeader开头）
+     * @param length 数据报长度
+     */
+    void Store(const char* data, size_t length) {
+        if (length < sizeof(UdpPacketHeader)) {
+            return;
+        }
+
+        uint32_t sequenceNumber = ReadSequenceNumber(data);
+        {
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            Slot& slot = m_slots[sequenceNumber % m_slots.size()];
+            slot.data.assign(data, data + length);  // 复用已分配的容量
+            slot.sequenceNumber = sequenceNumber;
+            slot.valid = true;
+        }
+        m_packetsStored.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 查找指定序列号的数据报，在读锁保护下拷贝到out
+     *
+     * 拷贝之后再发送，发送期间不持有锁，不阻塞广播线程的Store()。
+     *
+     * @param sequenceNumber 序列号
+     * @param out 输出：数据报内容（复用调用方缓冲区的容量）
+     * @return true 如果找到
+     */
+    bool Find(uint32_t sequenceNumber, std::vector<char>& out) const {
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            const Slot& slot = m_slots[sequenceNumber % m_slots.size()];
+            if (slot.valid && slot.sequenceNumber == sequenceNumber) {
+                out.assign(slot.data.begin(), slot.data.end());
+                m_retransmitted.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    size_t Capacity() const { return m_slots.size(); }
+
+    /**
+     * @brief 获取统计快照
+     */
+    RetransmitStats GetStats() const {
+        RetransmitStats stats;
+        stats.packetsStored = m_packetsStored.load(std::memory_order_relaxed);
+        stats.retransmitted = m_retransmitted.load(std::memory_order_relaxed);
+        stats.misses = m_misses.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    struct Slot {
+        std::vector<char> data;         // 编码后的数据报
+        uint32_t sequenceNumber = 0;    // 数据报序列号
+        bool valid = false;             // 是否已写入
+    };
+
+    static uint32_t ReadSequenceNumber(const char* data) {
+        uint32_t sequenceNumber = 0;
+        std::memcpy(&sequenceNumber, data + offsetof(UdpPacketHeader, sequenceNumber),
+                    sizeof(sequenceNumber));
+        return sequenceNumber;
+    }
+
+    mutable std::shared_mutex m_mutex;
+    std::vector<Slot> m_slots;
+
+    std::atomic<uint64_t> m_packetsStored{0};
+    mutable std::atomic<uint64_t> m_retransmitted{0};
+    mutable std::atomic<uint64_t> m_misses{0};
+};
+
+} // namespace zygl::interfaces
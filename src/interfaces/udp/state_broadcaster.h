@@ -1,6 +1,11 @@
 #pragma once
 
 #include "udp_protocol.h"
+#include "udp_batch_sender.h"
+#include "resource_monitor_cache.h"
+#include "payload_compressor.h"
+#include "token_bucket_pacer.h"
+#include "retransmit_ring.h"
 #include "../../application/services/monitoring_service.h"
 #include <sys/socket.h>
 #include <netinet/in.h>
@@ -11,9 +16,22 @@
 #include <memory>
 #include <chrono>
 #include <cstring>
+#include <new>
+#include <array>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
 
 namespace zygl::interfaces {
 
+/**
+ * @brief 广播限速统计（按通道：0=机箱状态，1=告警，2=业务链标签）
+ */
+struct BroadcastPacingStats {
+    uint64_t deferredPackets[3] = {};       // 因限速未能立即发送的数据报数
+    uint64_t supersededPackets[3] = {};     // 等待期间被新一轮广播取代、最终未发送的数据报数
+};
+
 /**
  * @brief StateBroadcaster - UDP状态广播器
  * 
@@ -22,9 +40,26 @@ namespace zygl::interfaces {
  * 2. 使用UDP多播协议，支持多个前端同时接收
  * 3. 三种广播周期可配置
  * 
+ * 调度方式：
+ * - 每个通道维护绝对截止时间（上一个截止时间 + 周期），周期发送不随发送耗时漂移
+ * - 广播线程在最早的截止时间上阻塞等待，空闲时不占用CPU
+ * - 仓储提交/新告警通过Notify*Changed()唤醒广播线程，变更立即推送
+ *   （同一通道事件触发发送之间至少间隔EVENT_MIN_GAP，合并突发变更）
+ * - Stop()直接唤醒广播线程，停止延迟不超过一轮正在进行的发送
+ * 
+ * 发送路径：
+ * - 数据包直接编码到池化缓冲区（DatagramBatch），不再按值组装后拷贝
+ * - 一轮广播的所有数据报通过一次sendmmsg发送
+ * - 发送错误和EAGAIN计入统计（GetSendStats），SO_SNDBUF可调
+ * - 告警/标签按数据版本缓存编码结果，版本不变时只更新包头序列号和时间戳
+ * - 可选zlib压缩告警/标签载荷（SetCompressionEnabled，需ZLIB编译选项）
+ * - 可选令牌桶限速（SetPacing，每秒数据报数/字节数），按优先级发送：
+ *   机箱状态 > 告警 > 业务链标签；高优先级通道有积压时低优先级通道等待
+ * 
  * 线程安全：
  * - 运行在独立线程中
  * - 通过std::atomic<bool>控制启停
+ * - Notify*Changed()可以被任意线程调用
  */
 class StateBroadcaster {
 public:
@@ -35,19 +70,24 @@ class StateBroadcaster {
      * @param chassisBroadcastInterval 机箱状态广播间隔（毫秒）
      * @param alertBroadcastInterval 告警广播间隔（毫秒）
      * @param labelBroadcastInterval 标签广播间隔（毫秒）
+     * @param sendBufferBytes 发送socket的SO_SNDBUF大小（字节），<=0表示使用系统默认值
      */
     StateBroadcaster(
         std::shared_ptr<application::MonitoringService> monitoringService,
         uint32_t chassisBroadcastInterval = 1000,    // 默认1秒
         uint32_t alertBroadcastInterval = 2000,       // 默认2秒
-        uint32_t labelBroadcastInterval = 5000)       // 默认5秒
+        uint32_t labelBroadcastInterval = 5000,       // 默认5秒
+        int sendBufferBytes = 0)                      // 默认系统值
         : m_monitoringService(monitoringService),
+          m_resourceMonitorCache(std::make_shared<ResourceMonitorCache>(monitoringService)),
+          m_retransmitRing(std::make_shared<RetransmitRing>()),
           m_chassisBroadcastInterval(chassisBroadcastInterval),
           m_alertBroadcastInterval(alertBroadcastInterval),
           m_labelBroadcastInterval(labelBroadcastInterval),
+          m_sendBufferBytes(sendBufferBytes),
           m_running(false),
-          m_socketFd(-1),
-          m_sequenceNumber(0) {
+          m_sequenceNumber(0),
+          m_responseID(0) {
     }
 
     /**
@@ -67,17 +107,8 @@ class StateBroadcaster {
             return false;  // 已经在运行
         }
 
-        // 创建UDP socket
-        m_socketFd = socket(AF_INET, SOCK_DGRAM, 0);
-        if (m_socketFd < 0) {
-            return false;
-        }
-
-        // 设置多播TTL
-        int ttl = 64;
-        if (setsockopt(m_socketFd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0) {
-            close(m_socketFd);
-            m_socketFd = -1;
+        // 创建非阻塞UDP发送socket（设置多播TTL和SO_SNDBUF）
+        if (!m_sender.Open(m_sendBufferBytes, 64)) {
             return false;
         }
 
@@ -88,6 +119,10 @@ class StateBroadcaster {
         m_multicastAddr.sin_port = htons(STATE_BROADCAST_PORT);
 
         // 启动广播线程
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_pendingEvents = 0;
+        }
         m_running.store(true);
         m_broadcastThread = std::thread(&StateBroadcaster::BroadcastLoop, this);
 
@@ -102,16 +137,18 @@ class StateBroadcaster {
             return;  // 未运行
         }
 
-        m_running.store(false);
+        {
+            // 在锁内修改运行标志，避免广播线程错过唤醒
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_running.store(false);
+        }
+        m_wakeCv.notify_all();
         
         if (m_broadcastThread.joinable()) {
             m_broadcastThread.join();
         }
 
-        if (m_socketFd >= 0) {
-            close(m_socketFd);
-            m_socketFd = -1;
-        }
+        m_sender.Close();
     }
 
     /**
@@ -121,224 +158,545 @@ class StateBroadcaster {
         return m_running.load();
     }
 
+    /**
+     * @brief 获取发送统计（发送数、错误数、EAGAIN次数等）
+     */
+    UdpSendStats GetSendStats() const {
+        return m_sender.GetStats();
+    }
+
+    /**
+     * @brief 启用/禁用告警和标签数据报的zlib压缩
+     * 
+     * 应在Start()之前调用。压缩后的数据报在包头reserved[0]置PACKET_FLAG_COMPRESSED，
+     * 格式见payload_compressor.h。
+     * 
+     * @param enabled 是否启用
+     * @return 实际是否启用（未编译zlib支持时返回false）
+     */
+    bool SetCompressionEnabled(bool enabled) {
+        m_compressionEnabled = enabled && PayloadCompressor::IsAvailable();
+        m_alertBatchValid = false;
+        m_labelBatchValid = false;
+        return m_compressionEnabled;
+    }
+
+    /**
+     * @brief 配置多播发送限速（令牌桶）
+     * 
+     * 应在Start()之前调用。两个速率都为0时不限速。
+     * 
+     * @param packetsPerSecond 每秒最多数据报数，0表示不限制
+     * @param bytesPerSecond 每秒最多字节数，0表示不限制
+     */
+    void SetPacing(uint32_t packetsPerSecond, uint64_t bytesPerSecond) {
+        m_pacer.Configure(packetsPerSecond, bytesPerSecond);
+    }
+
+    /**
+     * @brief 获取限速统计（延迟/被取代的数据报数，用于调整限速参数）
+     */
+    BroadcastPacingStats GetPacingStats() const {
+        BroadcastPacingStats stats;
+        for (size_t i = 0; i < CHANNEL_COUNT; ++i) {
+            stats.deferredPackets[i] = m_deferredPackets[i].load(std::memory_order_relaxed);
+            stats.supersededPackets[i] = m_supersededPackets[i].load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    /**
+     * @brief 获取资源监控报文缓存（供CommandListener回复F000H请求复用）
+     */
+    std::shared_ptr<ResourceMonitorCache> GetResourceMonitorCache() const {
+        return m_resourceMonitorCache;
+    }
+
+    /**
+     * @brief 获取重传环（供CommandListener响应NACK重传请求）
+     */
+    std::shared_ptr<RetransmitRing> GetRetransmitRing() const {
+        return m_retransmitRing;
+    }
+
+    /**
+     * @brief 通知机箱状态已变化（如机箱仓储提交了新数据），立即广播
+     */
+    void NotifyChassisChanged() {
+        Notify(CHANNEL_CHASSIS);
+    }
+
+    /**
+     * @brief 通知告警已变化（新告警/告警确认），立即广播
+     */
+    void NotifyAlertsChanged() {
+        Notify(CHANNEL_ALERTS);
+    }
+
+    /**
+     * @brief 通知业务链路已变化，立即广播标签
+     */
+    void NotifyStacksChanged() {
+        Notify(CHANNEL_LABELS);
+    }
+
 private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 广播通道（机箱状态/告警/业务链标签）
+     */
+    enum Channel : size_t {
+        CHANNEL_CHASSIS = 0,
+        CHANNEL_ALERTS = 1,
+        CHANNEL_LABELS = 2,
+        CHANNEL_COUNT = 3
+    };
+
+    /**
+     * @brief 通道调度状态
+     * 
+     * nextDeadline按"上一个截止时间 + 周期"推进（绝对时间），不随发送耗时漂移；
+     * dirty表示收到变更通知，需要在lastSent + EVENT_MIN_GAP之后尽快发送。
+     */
+    struct ChannelSchedule {
+        std::chrono::milliseconds interval{1000};
+        Clock::time_point nextDeadline;     // 下一次周期发送的绝对截止时间
+        Clock::time_point lastSent;         // 最近一次发送时间
+        bool dirty = false;                 // 是否有未发送的变更
+
+        Clock::time_point DueTime() const {
+            if (dirty) {
+                return std::min(nextDeadline, lastSent + EVENT_MIN_GAP);
+            }
+            return nextDeadline;
+        }
+    };
+
+    // 同一通道两次事件触发发送的最小间隔（合并突发变更）
+    static constexpr std::chrono::milliseconds EVENT_MIN_GAP{50};
+
+    /**
+     * @brief 通道发送队列：批次中[next, end)范围的数据报等待发送
+     */
+    struct ChannelQueue {
+        size_t next = 0;            // 下一个待发送的槽位
+        size_t end = 0;             // 本轮广播的数据报数
+        size_t deferredMark = 0;    // 已计入延迟统计的槽位上限（避免重复计数）
+
+        bool HasPending() const { return next < end; }
+    };
+
+    /**
+     * @brief 标记通道有变更并唤醒广播线程
+     */
+    void Notify(Channel channel) {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_pendingEvents |= (1u << channel);
+        }
+        m_wakeCv.notify_one();
+    }
+
     /**
      * @brief 广播循环（运行在独立线程）
+     * 
+     * 在所有通道中最早的截止时间上阻塞等待（condition_variable::wait_until），
+     * 被变更通知或Stop()提前唤醒。空闲时不再周期性醒来。
      */
     void BroadcastLoop() {
-        auto lastChassisTime = std::chrono::steady_clock::now();
-        auto lastAlertTime = std::chrono::steady_clock::now();
-        auto lastLabelTime = std::chrono::steady_clock::now();
-
-        while (m_running.load()) {
-            auto now = std::chrono::steady_clock::now();
+        auto now = Clock::now();
+        std::array<ChannelSchedule, CHANNEL_COUNT> schedules;
+        const uint32_t intervals[CHANNEL_COUNT] = {
+            m_chassisBroadcastInterval, m_alertBroadcastInterval, m_labelBroadcastInterval
+        };
+        for (size_t i = 0; i < CHANNEL_COUNT; ++i) {
+            schedules[i].interval = std::chrono::milliseconds(std::max<uint32_t>(intervals[i], 1));
+            schedules[i].nextDeadline = now + schedules[i].interval;
+            schedules[i].lastSent = now - EVENT_MIN_GAP;
+        }
 
-            // 广播机箱状态
-            if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastChassisTime).count() 
-                >= m_chassisBroadcastInterval) {
-                if (!m_running.load()) break;  // 再次检查运行状态
-                BroadcastChassisStates();
-                lastChassisTime = now;
+        while (true) {
+            auto wakeAt = schedules[0].DueTime();
+            for (const auto& schedule : schedules) {
+                wakeAt = std::min(wakeAt, schedule.DueTime());
+            }
+            
+            // 有积压的数据报时，在令牌足够时醒来继续发送
+            for (size_t i = 0; i < CHANNEL_COUNT; ++i) {
+                const auto& queue = m_queues[i];
+                if (queue.HasPending()) {
+                    size_t length = GetBatch(static_cast<Channel>(i)).Length(queue.next);
+                    wakeAt = std::min(wakeAt, m_pacer.NextReadyTime(length, Clock::now()));
+                    break;  // 严格优先级：只有最高优先级的积压通道决定唤醒时间
+                }
             }
 
-            // 广播告警消息
-            if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastAlertTime).count() 
-                >= m_alertBroadcastInterval) {
-                if (!m_running.load()) break;  // 再次检查运行状态
-                BroadcastAlerts();
-                lastAlertTime = now;
+            uint32_t events = 0;
+            {
+                std::unique_lock<std::mutex> lock(m_wakeMutex);
+                m_wakeCv.wait_until(lock, wakeAt, [this] {
+                    return !m_running.load() || m_pendingEvents != 0;
+                });
+                if (!m_running.load()) {
+                    break;
+                }
+                events = m_pendingEvents;
+                m_pendingEvents = 0;
             }
 
-            // 广播业务链标签
-            if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastLabelTime).count() 
-                >= m_labelBroadcastInterval) {
-                if (!m_running.load()) break;  // 再次检查运行状态
-                BroadcastStackLabels();
-                lastLabelTime = now;
+            for (size_t i = 0; i < CHANNEL_COUNT; ++i) {
+                if (events & (1u << i)) {
+                    schedules[i].dirty = true;
+                }
             }
 
-            // 短暂休眠，避免CPU占用过高，并允许快速响应停止请求
-            for (int i = 0; i < 10 && m_running.load(); ++i) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            now = Clock::now();
+            for (size_t i = 0; i < CHANNEL_COUNT && m_running.load(); ++i) {
+                auto& schedule = schedules[i];
+                if (now < schedule.DueTime()) {
+                    continue;
+                }
+
+                BroadcastChannel(static_cast<Channel>(i));
+                schedule.lastSent = now;
+                schedule.dirty = false;
+
+                // 周期截止时间按固定步长推进；落后多个周期时直接跳到下一个未来的截止时间
+                if (now >= schedule.nextDeadline) {
+                    auto behind = (now - schedule.nextDeadline) / schedule.interval;
+                    schedule.nextDeadline += schedule.interval * (behind + 1);
+                }
             }
+
+            FlushPending();
         }
     }
 
     /**
-     * @brief 广播所有机箱的状态
+     * @brief 将已发送的告警/标签数据报写入重传环
      * 
-     * 使用ResourceMonitorResponsePacket协议，包含所有9个机箱的状态
+     * 机箱状态报文使用资源监控格式（无序列号），不进入重传环。
      */
-    void BroadcastChassisStates() {
-        // 获取系统概览
-        auto response = m_monitoringService->GetSystemOverview();
-        if (!response.success) {
+    void RememberSent(Channel channel, const DatagramBatch& batch, size_t first, size_t count) {
+        if (channel == CHANNEL_CHASSIS) {
             return;
         }
+        for (size_t i = first; i < first + count; ++i) {
+            m_retransmitRing->Store(batch.Data(i), batch.Length(i));
+        }
+    }
 
-        // 创建资源监控响应数据包
-        ResourceMonitorResponsePacket packet;
-        
-        // 设置响应ID（从0开始递增）
-        static uint32_t responseID = 0;
-        packet.responseID = responseID++;
-        if (responseID == 0xFFFFFFFF) {
-            responseID = 0;  // 防止溢出
+    /**
+     * @brief 获取通道对应的数据报批次
+     */
+    DatagramBatch& GetBatch(Channel channel) {
+        switch (channel) {
+            case CHANNEL_ALERTS:
+                return m_alertBatch;
+            case CHANNEL_LABELS:
+                return m_labelBatch;
+            default:
+                return m_chassisBatch;
         }
+    }
+
+    /**
+     * @brief 将通道批次中的所有数据报加入发送队列
+     * 
+     * 上一轮尚未发送完的数据报被新一轮取代（广播内容是完整快照，只需发送最新的）。
+     */
+    void Enqueue(Channel channel) {
+        auto& queue = m_queues[channel];
+        if (queue.HasPending()) {
+            m_supersededPackets[channel].fetch_add(queue.end - queue.next, std::memory_order_relaxed);
+        }
+        queue.next = 0;
+        queue.end = GetBatch(channel).Size();
+        queue.deferredMark = 0;
+    }
+
+    /**
+     * @brief 按优先级发送积压的数据报（受令牌桶限制）
+     * 
+     * 通道按枚举顺序（机箱状态 > 告警 > 标签）发送；某通道因令牌不足停止时，
+     * 低优先级通道本次不发送。未能发送的数据报计入延迟统计。
+     */
+    void FlushPending() {
+        auto now = Clock::now();
+        bool blocked = false;
         
-        // 初始化数组为0（默认状态为异常/离线）
-        std::memset(packet.boardStates, 0, sizeof(packet.boardStates));
-        std::memset(packet.taskStates, 0, sizeof(packet.taskStates));
-        
-        // 遍历所有机箱，填充板卡和任务状态
-        for (const auto& chassisDTO : response.data.chassis) {
-            int32_t chassisIndex = chassisDTO.chassisNumber - 1;  // 机箱号1-9转换为索引0-8
-            
-            // 检查机箱号是否有效
-            if (chassisIndex < 0 || chassisIndex >= 9) {
+        for (size_t i = 0; i < CHANNEL_COUNT; ++i) {
+            auto& queue = m_queues[i];
+            if (!queue.HasPending()) {
                 continue;
             }
             
-            // 填充板卡状态（12块板卡）
-            for (size_t boardIdx = 0; boardIdx < chassisDTO.boards.size() && boardIdx < 12; ++boardIdx) {
-                const auto& boardDTO = chassisDTO.boards[boardIdx];
-                
-                // 板卡状态：1=正常，0=异常
-                // boardStatus: -1=未知，0=正常，1=异常，2=离线
-                if (boardDTO.boardStatus == 0) {
-                    packet.boardStates[chassisIndex][boardIdx] = 1;  // 正常
-                } else {
-                    packet.boardStates[chassisIndex][boardIdx] = 0;  // 异常或离线
+            auto& batch = GetBatch(static_cast<Channel>(i));
+            if (!blocked) {
+                size_t admitted = m_pacer.Admit(batch, queue.next, queue.end, now);
+                if (admitted > 0) {
+                    m_sender.Send(batch, m_multicastAddr, queue.next, admitted);
+                    RememberSent(static_cast<Channel>(i), batch, queue.next, admitted);
+                    queue.next += admitted;
                 }
-                
-                // 填充任务状态（每个板卡最多8个任务）
-                for (size_t taskIdx = 0; taskIdx < boardDTO.taskStatuses.size() && taskIdx < 8; ++taskIdx) {
-                    const std::string& status = boardDTO.taskStatuses[taskIdx];
-                    
-                    // 任务状态：1=正常，2=异常
-                    // 根据任务状态字符串判断
-                    if (status.empty() || status == "unknown") {
-                        packet.taskStates[chassisIndex][boardIdx][taskIdx] = 0;  // 未知
-                    } else if (status == "normal" || status == "running") {
-                        packet.taskStates[chassisIndex][boardIdx][taskIdx] = 1;  // 正常
-                    } else {
-                        packet.taskStates[chassisIndex][boardIdx][taskIdx] = 2;  // 异常
-                    }
+            }
+            
+            if (queue.HasPending()) {
+                blocked = true;
+                size_t from = std::max(queue.next, queue.deferredMark);
+                if (from < queue.end) {
+                    m_deferredPackets[i].fetch_add(queue.end - from, std::memory_order_relaxed);
+                    queue.deferredMark = queue.end;
                 }
             }
         }
+    }
+
+    /**
+     * @brief 广播指定通道
+     */
+    void BroadcastChannel(Channel channel) {
+        switch (channel) {
+            case CHANNEL_CHASSIS:
+                BroadcastChassisStates();
+                break;
+            case CHANNEL_ALERTS:
+                BroadcastAlerts();
+                break;
+            case CHANNEL_LABELS:
+                BroadcastStackLabels();
+                break;
+            default:
+                break;
+        }
+    }
+
+    /**
+     * @brief 广播所有机箱的状态
+     * 
+     * 使用ResourceMonitorPacket协议，包含所有9个机箱的状态。
+     * 报文由ResourceMonitorCache按快照版本编码，这里只拷贝并填写响应ID。
+     */
+    void BroadcastChassisStates() {
+        auto cached = m_resourceMonitorCache->GetPacket();
+        if (!cached) {
+            return;
+        }
+
+        m_chassisBatch.Clear();
+        char* buffer = m_chassisBatch.Append();
+        std::memcpy(buffer, cached.get(), sizeof(ResourceMonitorResponsePacket));
+        
+        // 设置响应ID（从0开始递增，溢出后自然回绕）
+        auto* packet = reinterpret_cast<ResourceMonitorResponsePacket*>(buffer);
+        packet->responseID = m_responseID++;
         
-        // 发送数据包（总计1000字节）
-        SendPacket(&packet, sizeof(packet));
+        // 加入发送队列（总计1000字节）
+        m_chassisBatch.SetLength(0, sizeof(ResourceMonitorResponsePacket));
+        Enqueue(CHANNEL_CHASSIS);
     }
 
     /**
      * @brief 广播告警消息
+     * 
+     * 告警数据版本未变化时复用上一轮编码（含压缩）的数据报，只更新序列号和时间戳。
      */
     void BroadcastAlerts() {
+        uint64_t version = m_monitoringService->GetAlertsVersion();
+        if (m_alertBatchValid && m_alertBatchVersion == version) {
+            RestampPackets(m_alertBatch);
+        } else {
+            if (!EncodeAlerts()) {
+                return;
+            }
+            m_alertBatchVersion = version;
+            m_alertBatchValid = true;
+        }
+
+        Enqueue(CHANNEL_ALERTS);
+    }
+
+    /**
+     * @brief 编码告警消息
+     * 
+     * 每个数据报最多MAX_ALERTS_PER_DATAGRAM条告警，没有未确认告警时批次为空。
+     * 
+     * @return false 如果获取告警失败
+     */
+    bool EncodeAlerts() {
         // 获取未确认的告警
         auto response = m_monitoringService->GetUnacknowledgedAlerts();
-        if (!response.success || response.data.alerts.empty()) {
-            return;
+        if (!response.success) {
+            return false;
         }
 
-        // 将告警分批发送（每包最多32条）
-        AlertMessagePacket packet;
-        packet.header.sequenceNumber = m_sequenceNumber++;
-        packet.header.timestamp = GetCurrentTimestampMs();
+        m_alertBatch.Clear();
+        char* buffer = nullptr;
+        int32_t alertCount = 0;
         
         for (const auto& alertDTO : response.data.alerts) {
-            if (packet.alertCount >= 32) {
-                // 当前包已满，发送并创建新包
-                SendPacket(&packet, sizeof(packet));
-                
-                packet = AlertMessagePacket();
-                packet.header.sequenceNumber = m_sequenceNumber++;
-                packet.header.timestamp = GetCurrentTimestampMs();
+            if (buffer == nullptr || alertCount >= MAX_ALERTS_PER_DATAGRAM) {
+                // 当前数据报已满，封包后开始新的数据报
+                if (buffer != nullptr) {
+                    FinishCountedPacket(m_alertBatch, buffer, alertCount,
+                                        ALERT_PACKET_PREFIX_SIZE, sizeof(domain::Alert));
+                }
+                buffer = BeginPacket(m_alertBatch, PacketType::AlertMessage);
+                alertCount = 0;
             }
             
-            // 添加告警到当前包 - 构造Alert对象
-            auto& alert = packet.alerts[packet.alertCount++];
-            alert = domain::Alert(
+            // 直接在缓冲区中构造Alert对象
+            char* slot = buffer + ALERT_PACKET_PREFIX_SIZE + alertCount * sizeof(domain::Alert);
+            auto* alert = new (slot) domain::Alert(
                 alertDTO.alertUUID.c_str(),
                 static_cast<domain::AlertType>(alertDTO.alertType)
             );
-            alert.SetTimestamp(alertDTO.timestamp);
-            alert.SetRelatedEntity(alertDTO.relatedEntity.c_str());
+            alertCount++;
+            alert->SetTimestamp(alertDTO.timestamp);
+            alert->SetRelatedEntity(alertDTO.relatedEntity.c_str());
             
             // 添加告警消息
             for (const auto& msg : alertDTO.messages) {
-                alert.AddMessage(msg.c_str());
+                alert->AddMessage(msg.c_str());
             }
             
             if (alertDTO.isAcknowledged) {
-                alert.Acknowledge();
+                alert->Acknowledge();
             }
         }
         
-        // 发送最后一个包
-        if (packet.alertCount > 0) {
-            SendPacket(&packet, sizeof(packet));
+        // 封装最后一个数据报
+        if (buffer != nullptr) {
+            FinishCountedPacket(m_alertBatch, buffer, alertCount,
+                                ALERT_PACKET_PREFIX_SIZE, sizeof(domain::Alert));
         }
+        return true;
     }
 
     /**
      * @brief 广播业务链标签
+     * 
+     * 业务链路数据版本未变化时复用上一轮编码（含压缩）的数据报，只更新序列号和时间戳。
      */
     void BroadcastStackLabels() {
+        uint64_t version = m_monitoringService->GetStacksVersion();
+        if (m_labelBatchValid && m_labelBatchVersion == version) {
+            RestampPackets(m_labelBatch);
+        } else {
+            if (!EncodeStackLabels()) {
+                return;
+            }
+            m_labelBatchVersion = version;
+            m_labelBatchValid = true;
+        }
+
+        Enqueue(CHANNEL_LABELS);
+    }
+
+    /**
+     * @brief 编码业务链标签
+     * 
+     * 每个数据报最多MAX_STACKS_PER_DATAGRAM个业务链，没有业务链时批次为空。
+     * 
+     * @return false 如果获取业务链失败
+     */
+    bool EncodeStackLabels() {
         // 获取所有业务链信息
         auto response = m_monitoringService->GetAllStacks();
-        if (!response.success || response.data.stacks.empty()) {
-            return;
+        if (!response.success) {
+            return false;
         }
 
-        // 创建标签数据包
-        StackLabelPacket packet;
-        packet.header.sequenceNumber = m_sequenceNumber++;
-        packet.header.timestamp = GetCurrentTimestampMs();
+        using StackEntry = StackLabelPacket::StackEntry;
+        
+        m_labelBatch.Clear();
+        char* buffer = nullptr;
+        int32_t stackCount = 0;
         
         for (const auto& stackDTO : response.data.stacks) {
-            if (packet.stackCount >= 64) {
-                // 包已满，发送并创建新包
-                SendPacket(&packet, sizeof(packet));
-                
-                packet = StackLabelPacket();
-                packet.header.sequenceNumber = m_sequenceNumber++;
-                packet.header.timestamp = GetCurrentTimestampMs();
+            if (buffer == nullptr || stackCount >= MAX_STACKS_PER_DATAGRAM) {
+                // 当前数据报已满，封包后开始新的数据报
+                if (buffer != nullptr) {
+                    FinishCountedPacket(m_labelBatch, buffer, stackCount,
+                                        STACK_LABEL_PACKET_PREFIX_SIZE, sizeof(StackEntry));
+                }
+                buffer = BeginPacket(m_labelBatch, PacketType::StackLabel);
+                stackCount = 0;
             }
             
-            // 添加业务链到当前包
-            auto& entry = packet.stacks[packet.stackCount++];
-            std::strncpy(entry.stackUUID, stackDTO.stackUUID.c_str(), 63);
-            std::strncpy(entry.stackName, stackDTO.stackName.c_str(), 127);
-            entry.deployStatus = stackDTO.deployStatus;
-            entry.runningStatus = stackDTO.runningStatus;
-            entry.labelCount = static_cast<int32_t>(stackDTO.labelUUIDs.size());
+            // 直接在缓冲区中填充业务链条目
+            auto* entry = reinterpret_cast<StackEntry*>(
+                buffer + STACK_LABEL_PACKET_PREFIX_SIZE + stackCount * sizeof(StackEntry));
+            std::memset(static_cast<void*>(entry), 0, sizeof(StackEntry));
+            stackCount++;
+            
+            std::strncpy(entry->stackUUID, stackDTO.stackUUID.c_str(), 63);
+            std::strncpy(entry->stackName, stackDTO.stackName.c_str(), 127);
+            entry->deployStatus = stackDTO.deployStatus;
+            entry->runningStatus = stackDTO.runningStatus;
+            entry->labelCount = static_cast<int32_t>(stackDTO.labelUUIDs.size());
             
             // 填充标签
             for (size_t i = 0; i < stackDTO.labelUUIDs.size() && i < 8; ++i) {
-                std::strncpy(entry.labels[i].labelUUID, stackDTO.labelUUIDs[i].c_str(), 63);
-                std::strncpy(entry.labels[i].labelName, stackDTO.labelNames[i].c_str(), 127);
+                std::strncpy(entry->labels[i].labelUUID, stackDTO.labelUUIDs[i].c_str(), 63);
+                std::strncpy(entry->labels[i].labelName, stackDTO.labelNames[i].c_str(), 127);
             }
         }
         
-        // 发送最后一个包
-        if (packet.stackCount > 0) {
-            SendPacket(&packet, sizeof(packet));
+        // 封装最后一个数据报
+        if (buffer != nullptr) {
+            FinishCountedPacket(m_labelBatch, buffer, stackCount,
+                                STACK_LABEL_PACKET_PREFIX_SIZE, sizeof(StackEntry));
         }
+        return true;
     }
 
     /**
-     * @brief 发送数据包
+     * @brief 在批次中开始一个新的带包头数据报
+     * 
+     * @return 数据报缓冲区起始地址（包头已构造）
      */
-    void SendPacket(const void* data, size_t size) {
-        if (m_socketFd < 0) {
-            return;
+    char* BeginPacket(DatagramBatch& batch, PacketType packetType) {
+        char* buffer = batch.Append();
+        auto* header = new (buffer) UdpPacketHeader();
+        header->packetType = static_cast<uint16_t>(packetType);
+        header->sequenceNumber = m_sequenceNumber++;
+        header->timestamp = GetCurrentTimestampMs();
+        return buffer;
+    }
+
+    /**
+     * @brief 封装"包头 + 数量 + 条目数组"格式的数据报
+     * 
+     * 写入数量字段，设置包头dataLength和批次中的有效长度；启用压缩时原地压缩载荷。
+     * buffer必须是批次中最后追加的槽位。
+     */
+    void FinishCountedPacket(DatagramBatch& batch, char* buffer, int32_t count,
+                             size_t prefixSize, size_t entrySize) {
+        std::memcpy(buffer + sizeof(UdpPacketHeader), &count, sizeof(count));
+        
+        size_t totalLength = prefixSize + static_cast<size_t>(count) * entrySize;
+        auto* header = reinterpret_cast<UdpPacketHeader*>(buffer);
+        header->dataLength = static_cast<uint32_t>(totalLength - sizeof(UdpPacketHeader));
+        
+        if (m_compressionEnabled) {
+            m_compressor.CompressInPlace(buffer, totalLength);
         }
+        
+        batch.SetLength(batch.Size() - 1, totalLength);
+    }
 
-        sendto(m_socketFd, data, size, 0, 
-               (struct sockaddr*)&m_multicastAddr, 
-               sizeof(m_multicastAddr));
+    /**
+     * @brief 为复用的数据报分配新的序列号和时间戳（包头不压缩，可以直接修改）
+     */
+    void RestampPackets(DatagramBatch& batch) {
+        uint64_t timestamp = GetCurrentTimestampMs();
+        for (size_t i = 0; i < batch.Size(); ++i) {
+            auto* header = reinterpret_cast<UdpPacketHeader*>(batch.Data(i));
+            header->sequenceNumber = m_sequenceNumber++;
+            header->timestamp = timestamp;
+        }
     }
 
     /**
@@ -353,20 +711,50 @@ class StateBroadcaster {
 private:
     // 依赖服务
     std::shared_ptr<application::MonitoringService> m_monitoringService;
+    std::shared_ptr<ResourceMonitorCache> m_resourceMonitorCache;  // 资源监控报文缓存
+    std::shared_ptr<RetransmitRing> m_retransmitRing;               // 最近发送数据报（NACK重传）
     
     // 配置参数
     uint32_t m_chassisBroadcastInterval;    // 机箱状态广播间隔（毫秒）
     uint32_t m_alertBroadcastInterval;      // 告警广播间隔（毫秒）
     uint32_t m_labelBroadcastInterval;      // 标签广播间隔（毫秒）
+    int m_sendBufferBytes;                  // SO_SNDBUF大小（字节）
     
     // 运行状态
     std::atomic<bool> m_running;            // 是否正在运行
     std::thread m_broadcastThread;          // 广播线程
     
+    // 调度唤醒
+    std::mutex m_wakeMutex;                 // 保护m_pendingEvents
+    std::condition_variable m_wakeCv;       // 截止时间/变更通知/停止唤醒
+    uint32_t m_pendingEvents = 0;           // 待处理的变更通知（按Channel位）
+    
     // 网络相关
-    int m_socketFd;                         // UDP socket文件描述符
+    UdpBatchSender m_sender;                // 批量发送器（非阻塞socket + sendmmsg）
     struct sockaddr_in m_multicastAddr;     // 多播目标地址
     uint32_t m_sequenceNumber;              // 序列号（用于检测丢包）
+    uint32_t m_responseID;                  // 资源监控响应ID（从0开始）
+    
+    // 池化编码缓冲区（按通道划分，在各轮广播间复用）
+    DatagramBatch m_chassisBatch;           // 资源监控报文
+    DatagramBatch m_alertBatch;             // 告警数据报
+    DatagramBatch m_labelBatch;             // 业务链标签数据报
+    
+    // 编码结果对应的数据版本（版本不变时复用批次）
+    uint64_t m_alertBatchVersion = 0;
+    bool m_alertBatchValid = false;
+    uint64_t m_labelBatchVersion = 0;
+    bool m_labelBatchValid = false;
+    
+    // 限速与发送队列（只由广播线程访问，统计为原子计数器）
+    TokenBucketPacer m_pacer;
+    std::array<ChannelQueue, CHANNEL_COUNT> m_queues;
+    std::atomic<uint64_t> m_deferredPackets[CHANNEL_COUNT] = {};
+    std::atomic<uint64_t> m_supersededPackets[CHANNEL_COUNT] = {};
+    
+    // 载荷压缩（告警/标签）
+    bool m_compressionEnabled = false;
+    PayloadCompressor m_compressor;
 };
 
 } // namespace zygl::interfaces
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "udp_batch_sender.h"
+#include <algorithm>
+#include <chrono>
+
+namespace zygl::interfaces {
+
+/**
+ * @brief TokenBucketPacer - 多播发送限速器（令牌桶）
+ * 
+ * 同时限制每秒数据报数和每秒字节数，两个令牌桶都足够时才放行一个数据报。
+ * 桶容量（允许的突发）默认为约20ms的令牌，且至少容纳一个最大数据报，避免大数据报永远无法发送。
+ * 
+ * 速率为0表示不限制该维度；两个速率都为0时限速器禁用，Admit()放行所有数据报。
+ * 
+ * 线程安全：
+ * - 非线程安全，由单一发送线程使用（或由调用方加锁）
+ */
+class TokenBucketPacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 配置速率
+     * 
+     * @param packetsPerSecond 每秒数据报数，0表示不限制
+     * @param bytesPerSecond 每秒字节数，0表示不限制
+     * @param burstSeconds 桶容量对应的突发时长（秒）
+     */
+    void Configure(uint32_t packetsPerSecond, uint64_t bytesPerSecond, double burstSeconds = BURST_SECONDS) {
+        m_packetRate = static_cast<double>(packetsPerSecond);
+        m_byteRate = static_cast<double>(bytesPerSecond);
+
+        m_packetCapacity = std::max(1.0, m_packetRate * burstSeconds);
+        m_byteCapacity = std::max(static_cast<double>(MAX_UDP_PAYLOAD), m_byteRate * burstSeconds);
+
+        // 初始为满桶
+        m_packetTokens = m_packetCapacity;
+        m_byteTokens = m_byteCapacity;
+        m_lastRefill = Clock::now();
+    }
+
+    /**
+     * @brief 是否启用限速
+     */
+    bool IsEnabled() const {
+        return m_packetRate > 0.0 || m_byteRate > 0.0;
+    }
+
+    /**
+     * @brief 放行批次中从first开始、不超过end的连续数据报，并扣除令牌
+     * 
+     * @return 可以立即发送的数据报数量（可能为0）
+     */
+    size_t Admit(const DatagramBatch& batch, size_t first, size_t end, Clock::time_point now) {
+        if (!IsEnabled()) {
+            return end - first;
+        }
+
+        Refill(now);
+
+        size_t admitted = 0;
+        for (size_t i = first; i < end && TryConsume(batch.Length(i)); ++i) {
+            admitted++;
+        }
+        return admitted;
+    }
+
+    /**
+     * @brief 放行一个指定长度的数据报并扣除令牌
+     * 
+     * @return false 如果令牌不足（不扣除）
+     */
+    bool AdmitOne(size_t length, Clock::time_point now) {
+        if (!IsEnabled()) {
+            return true;
+        }
+        Refill(now);
+        return TryConsume(length);
+    }
+
+    /**
+     * @brief 计算令牌足够发送一个指定长度数据报的时间
+     * 
+     * @param length 数据报长度（字节）
+     * @param now 当前时间
+     */
+    Clock::time_point NextReadyTime(size_t length, Clock::time_point now) {
+        if (!IsEnabled()) {
+            return now;
+        }
+
+        Refill(now);
+
+        double waitSeconds = 0.0;
+        if (m_packetRate > 0.0 && m_packetTokens < 1.0) {
+            waitSeconds = std::max(waitSeconds, (1.0 - m_packetTokens) / m_packetRate);
+        }
+        double needBytes = std::min(static_cast<double>(length), m_byteCapacity);
+        if (m_byteRate > 0.0 && m_byteTokens < needBytes) {
+            waitSeconds = std::max(waitSeconds, (needBytes - m_byteTokens) / m_byteRate);
+        }
+
+        // 向上取整，避免醒来时令牌仍差一点而空转
+        return now + std::chrono::ceil<Clock::duration>(
+            std::chrono::duration<double>(waitSeconds));
+    }
+
+private:
+    /**
+     * @brief 两个令牌桶都足够时扣除一个数据报的令牌
+     */
+    bool TryConsume(size_t length) {
+        double bytes = static_cast<double>(length);
+        if ((m_packetRate > 0.0 && m_packetTokens < 1.0) ||
+            (m_byteRate > 0.0 && m_byteTokens < bytes)) {
+            return false;
+        }
+        if (m_packetRate > 0.0) {
+            m_packetTokens -= 1.0;
+        }
+        if (m_byteRate > 0.0) {
+            m_byteTokens -= bytes;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 按流逝时间补充令牌（不超过桶容量）
+     */
+    void Refill(Clock::time_point now) {
+        if (now <= m_lastRefill) {
+            return;
+        }
+        double elapsed = std::chrono::duration<double>(now - m_lastRefill).count();
+        m_lastRefill = now;
+
+        m_packetTokens = std::min(m_packetCapacity, m_packetTokens + elapsed * m_packetRate);
+        m_byteTokens = std::min(m_byteCapacity, m_byteTokens + elapsed * m_byteRate);
+    }
+
+    static constexpr double BURST_SECONDS = 0.02;   // 桶容量对应的突发时长
+
+    double m_packetRate = 0.0;          // 每秒数据报数
+    double m_byteRate = 0.0;            // 每秒字节数
+    double m_packetCapacity = 1.0;      // 数据报桶容量
+    double m_byteCapacity = 0.0;        // 字节桶容量
+    double m_packetTokens = 0.0;        // 当前数据报令牌
+    double m_byteTokens = 0.0;          // 当前字节令牌
+    Clock::time_point m_lastRefill = Clock::now();
+};
+
+} // namespace zygl::interfaces
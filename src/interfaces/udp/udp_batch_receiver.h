@@ -0,0 +1,308 @@
+#pragma once
+
+#include "udp_protocol.h"
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <atomic>
+#include <vector>
+
+namespace zygl::interfaces {
+
+/**
+ * @brief UDP接收统计快照
+ */
+struct UdpReceiveStats {
+    uint64_t packetsReceived = 0;   // 接收的数据报数
+    uint64_t bytesReceived = 0;     // 接收的字节数
+    uint64_t batches = 0;           // 收到数据的recvmmsg调用次数
+    uint64_t truncated = 0;         // 超过接收缓冲区被截断的数据报数
+    uint64_t kernelDrops = 0;       // 内核因接收缓冲区满丢弃的数据报数（SO_RXQ_OVFL）
+    uint64_t receiveErrors = 0;     // 接收错误次数（不含EAGAIN/EINTR）
+};
+
+/**
+ * @brief UdpBatchReceiver - 批量UDP接收器
+ *
+ * 职责：
+ * 1. 将已绑定的UDP socket设为非阻塞，可调SO_RCVBUF，开启SO_RXQ_OVFL丢包计数
+ *    和IP_PKTINFO（区分发往多播组和发往本机单播地址的数据报）
+ * 2. poll等待socket可读或停止信号（eventfd），停止时立即返回，不依赖收到数据
+ * 3. 使用recvmmsg一次系统调用接收多个数据报，缓冲区在整个生命周期内复用
+ *
+ * 线程安全：
+ * - Attach()/Detach()由所属对象的启停流程调用
+ * - Receive()由单一接收线程调用
+ * - Wake()和GetStats()可以被任意线程调用
+ */
+class UdpBatchReceiver {
+public:
+    static constexpr size_t BATCH_SIZE = 16;            // 每次recvmmsg最多接收的数据报数
+    static constexpr size_t DATAGRAM_BUFFER_SIZE = 65536;
+    static constexpr size_t MAX_BATCHES_PER_WAKEUP = 8; // 每次唤醒最多连续接收的批次数（之后重新poll）
+
+    UdpBatchReceiver() : m_socketFd(-1), m_wakeFd(-1) {}
+
+    ~UdpBatchReceiver() {
+        Detach();
+    }
+
+    // 禁止拷贝
+    UdpBatchReceiver(const UdpBatchReceiver&) = delete;
+    UdpBatchReceiver& operator=(const UdpBatchReceiver&) = delete;
+
+    /**
+     * @brief 接管一个已绑定的UDP socket
+     *
+     * @param socketFd 已绑定的socket（所有权仍归调用方，Detach()不关闭它）
+     * @param receiveBufferBytes SO_RCVBUF大小（字节），<=0表示使用系统默认值
+     * @return true 如果成功
+     */
+    bool Attach(int socketFd, int receiveBufferBytes = 0) {
+        if (socketFd < 0 || m_wakeFd >= 0) {
+            return false;
+        }
+
+        int flags = fcntl(socketFd, F_GETFL, 0);
+        if (flags < 0 || fcntl(socketFd, F_SETFL, flags | O_NONBLOCK) < 0) {
+            return false;
+        }
+
+        // SO_RCVBUF设置失败不影响功能，保留系统默认值
+        if (receiveBufferBytes > 0) {
+            setsockopt(socketFd, SOL_SOCKET, SO_RCVBUF,
+                       &receiveBufferBytes, sizeof(receiveBufferBytes));
+        }
+
+        // 开启内核丢包计数（不支持时kernelDrops保持为0）和目的地址信息
+        int enable = 1;
+        setsockopt(socketFd, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable));
+        setsockopt(socketFd, IPPROTO_IP, IP_PKTINFO, &enable, sizeof(enable));
+
+        m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_wakeFd < 0) {
+            return false;
+        }
+
+        m_socketFd = socketFd;
+        AllocateBuffers();
+        return true;
+    }
+
+    /**
+     * @brief 释放停止信号（不关闭socket）
+     */
+    void Detach() {
+        if (m_wakeFd >= 0) {
+            close(m_wakeFd);
+            m_wakeFd = -1;
+        }
+        m_socketFd = -1;
+    }
+
+    /**
+     * @brief 唤醒阻塞在Receive()中的线程（用于停止）
+     */
+    void Wake() {
+        if (m_wakeFd >= 0) {
+            uint64_t one = 1;
+            ssize_t rc = write(m_wakeFd, &one, sizeof(one));
+            (void)rc;
+        }
+    }
+
+    /**
+     * @brief 获取内核实际生效的SO_RCVBUF大小
+     *
+     * @return 字节数，未接管socket时返回-1
+     */
+    int GetReceiveBufferSize() const {
+        if (m_socketFd < 0) {
+            return -1;
+        }
+        int size = 0;
+        socklen_t len = sizeof(size);
+        if (getsockopt(m_socketFd, SOL_SOCKET, SO_RCVBUF, &size, &len) < 0) {
+            return -1;
+        }
+        return size;
+    }
+
+    /**
+     * @brief 等待并接收数据报
+     *
+     * 阻塞直到socket可读或被Wake()唤醒。可读时连续调用recvmmsg直到没有数据
+     * （最多MAX_BATCHES_PER_WAKEUP批），每个数据报调用一次回调。
+     *
+     * @param onDatagram 回调 void(const char* data, size_t length, const sockaddr_in& sender, bool multicast)，
+     *                   multicast表示数据报发往多播组（而不是本机单播地址）
+     * @return false 如果被Wake()唤醒或socket不可用（调用方应退出接收循环）
+     */
+    template<typename Fn>
+    bool Receive(Fn&& onDatagram) {
+        if (m_socketFd < 0 || m_wakeFd < 0) {
+            return false;
+        }
+
+        struct pollfd fds[2];
+        fds[0].fd = m_socketFd;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = m_wakeFd;
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+
+        int rc = poll(fds, 2, -1);
+        if (rc < 0) {
+            return errno == EINTR;
+        }
+        if (fds[1].revents != 0) {
+            return false;
+        }
+        if ((fds[0].revents & POLLIN) == 0) {
+            return (fds[0].revents & (POLLERR | POLLNVAL)) == 0;
+        }
+
+        for (size_t batch = 0; batch < MAX_BATCHES_PER_WAKEUP; ++batch) {
+            PrepareMessages();
+            int count = recvmmsg(m_socketFd, m_msgs.data(), BATCH_SIZE, MSG_DONTWAIT, nullptr);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    m_receiveErrors.fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+            }
+            if (count == 0) {
+                break;
+            }
+
+            m_batches.fetch_add(1, std::memory_order_relaxed);
+            m_packetsReceived.fetch_add(static_cast<uint64_t>(count), std::memory_order_relaxed);
+
+            uint64_t bytes = 0;
+            for (int i = 0; i < count; ++i) {
+                const struct msghdr& hdr = m_msgs[i].msg_hdr;
+                size_t length = m_msgs[i].msg_len;
+                bytes += length;
+
+                bool multicast = ParseControlMessages(hdr);
+                if (hdr.msg_flags & MSG_TRUNC) {
+                    m_truncated.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                onDatagram(m_buffers.data() + static_cast<size_t>(i) * DATAGRAM_BUFFER_SIZE,
+                           length, m_senders[i], multicast);
+            }
+            m_bytesReceived.fetch_add(bytes, std::memory_order_relaxed);
+
+            if (static_cast<size_t>(count) < BATCH_SIZE) {
+                break;  // 队列已取空
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 获取接收统计快照
+     */
+    UdpReceiveStats GetStats() const {
+        UdpReceiveStats stats;
+        stats.packetsReceived = m_packetsReceived.load(std::memory_order_relaxed);
+        stats.bytesReceived = m_bytesReceived.load(std::memory_order_relaxed);
+        stats.batches = m_batches.load(std::memory_order_relaxed);
+        stats.truncated = m_truncated.load(std::memory_order_relaxed);
+        stats.kernelDrops = m_kernelDrops.load(std::memory_order_relaxed);
+        stats.receiveErrors = m_receiveErrors.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    // 控制消息缓冲区：SO_RXQ_OVFL（一个uint32_t计数）+ IP_PKTINFO
+    static constexpr size_t CONTROL_BUFFER_SIZE =
+        CMSG_SPACE(sizeof(uint32_t)) + CMSG_SPACE(sizeof(struct in_pktinfo));
+
+    /**
+     * @brief 分配接收缓冲区（只在首次Attach时分配）
+     */
+    void AllocateBuffers() {
+        if (!m_buffers.empty()) {
+            return;
+        }
+        m_buffers.resize(BATCH_SIZE * DATAGRAM_BUFFER_SIZE);
+        m_controls.resize(BATCH_SIZE * CONTROL_BUFFER_SIZE);
+        m_msgs.resize(BATCH_SIZE);
+        m_iovecs.resize(BATCH_SIZE);
+        m_senders.resize(BATCH_SIZE);
+    }
+
+    /**
+     * @brief 重置mmsghdr数组（recvmmsg会改写长度字段）
+     */
+    void PrepareMessages() {
+        for (size_t i = 0; i < BATCH_SIZE; ++i) {
+            m_iovecs[i].iov_base = m_buffers.data() + i * DATAGRAM_BUFFER_SIZE;
+            m_iovecs[i].iov_len = DATAGRAM_BUFFER_SIZE;
+            std::memset(&m_msgs[i], 0, sizeof(struct mmsghdr));
+            m_msgs[i].msg_hdr.msg_name = &m_senders[i];
+            m_msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+            m_msgs[i].msg_hdr.msg_iov = &m_iovecs[i];
+            m_msgs[i].msg_hdr.msg_iovlen = 1;
+            m_msgs[i].msg_hdr.msg_control = m_controls.data() + i * CONTROL_BUFFER_SIZE;
+            m_msgs[i].msg_hdr.msg_controllen = CONTROL_BUFFER_SIZE;
+        }
+    }
+
+    /**
+     * @brief 读取控制消息
+     * 
+     * - SO_RXQ_OVFL：内核给出的是该socket累计丢包数
+     * - IP_PKTINFO：数据报的目的地址
+     * 
+     * @return true 如果数据报发往多播地址
+     */
+    bool ParseControlMessages(const struct msghdr& hdr) {
+        bool multicast = false;
+        for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(const_cast<struct msghdr*>(&hdr));
+             cmsg != nullptr;
+             cmsg = CMSG_NXTHDR(const_cast<struct msghdr*>(&hdr), cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL) {
+                uint32_t drops = 0;
+                std::memcpy(&drops, CMSG_DATA(cmsg), sizeof(drops));
+                m_kernelDrops.store(drops, std::memory_order_relaxed);
+            } else if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO) {
+                struct in_pktinfo info;
+                std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+                multicast = IN_MULTICAST(ntohl(info.ipi_addr.s_addr));
+            }
+        }
+        return multicast;
+    }
+
+    int m_socketFd;                             // 接收socket（不拥有）
+    int m_wakeFd;                               // 停止信号（eventfd）
+
+    std::vector<char> m_buffers;                // BATCH_SIZE个接收缓冲区（连续分配，复用）
+    std::vector<char> m_controls;               // 控制消息缓冲区
+    std::vector<struct mmsghdr> m_msgs;         // recvmmsg消息数组
+    std::vector<struct iovec> m_iovecs;         // 指向接收缓冲区的iovec
+    std::vector<struct sockaddr_in> m_senders;  // 发送方地址
+
+    // 接收统计
+    std::atomic<uint64_t> m_packetsReceived{0};
+    std::atomic<uint64_t> m_bytesReceived{0};
+    std::atomic<uint64_t> m_batches{0};
+    std::atomic<uint64_t> m_truncated{0};
+    std::atomic<uint64_t> m_kernelDrops{0};
+    std::atomic<uint64_t> m_receiveErrors{0};
+};
+
+} // namespace zygl::interfaces
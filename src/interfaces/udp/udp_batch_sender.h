@@ -0,0 +1,289 @@
+#pragma once
+
+#include "udp_protocol.h"
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cerrno>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace zygl::interfaces {
+
+/**
+ * @brief UDP发送统计快照
+ */
+struct UdpSendStats {
+    uint64_t packetsSent = 0;       // 成功发送的数据报数
+    uint64_t bytesSent = 0;         // 成功发送的字节数
+    uint64_t syscalls = 0;          // sendmmsg系统调用次数
+    uint64_t sendErrors = 0;        // 发送错误次数（不含EAGAIN）
+    uint64_t eagainCount = 0;       // 发送缓冲区满（EAGAIN/EWOULDBLOCK）次数
+    uint64_t packetsDropped = 0;    // 因发送失败被丢弃的数据报数
+};
+
+/**
+ * @brief DatagramBatch - 数据报批次（池化编码缓冲区）
+ *
+ * 每个槽位是一块MAX_UDP_PAYLOAD大小的缓冲区，首次使用时分配，
+ * 之后在各轮广播之间复用（Clear()只重置计数，不释放内存）。
+ * 编码器直接在槽位内构造数据包，发送时iovec直接指向槽位，
+ * 避免先按值组装数据包再拷贝。
+ *
+ * 线程安全：
+ * - 非线程安全，由单一编码/发送线程使用
+ */
+class DatagramBatch {
+public:
+    using Buffer = std::array<char, MAX_UDP_PAYLOAD>;
+
+    /**
+     * @brief 追加一个槽位并返回其缓冲区
+     *
+     * @return 槽位缓冲区（容量MAX_UDP_PAYLOAD），长度初始为0
+     */
+    char* Append() {
+        if (m_count == m_buffers.size()) {
+            m_buffers.push_back(std::make_unique<Buffer>());
+            m_lengths.push_back(0);
+        }
+        m_lengths[m_count] = 0;
+        return m_buffers[m_count++]->data();
+    }
+
+    /**
+     * @brief 设置槽位中有效数据的长度
+     */
+    void SetLength(size_t index, size_t length) {
+        if (index < m_count) {
+            m_lengths[index] = (length <= MAX_UDP_PAYLOAD) ? length : MAX_UDP_PAYLOAD;
+        }
+    }
+
+    /**
+     * @brief 清空批次（保留已分配的缓冲区）
+     */
+    void Clear() {
+        m_count = 0;
+    }
+
+    size_t Size() const { return m_count; }
+    bool Empty() const { return m_count == 0; }
+
+    char* Data(size_t index) { return m_buffers[index]->data(); }
+    const char* Data(size_t index) const { return m_buffers[index]->data(); }
+    size_t Length(size_t index) const { return m_lengths[index]; }
+
+private:
+    std::vector<std::unique_ptr<Buffer>> m_buffers;     // 池化缓冲区
+    std::vector<size_t> m_lengths;                      // 各槽位有效长度
+    size_t m_count = 0;                                 // 当前批次的槽位数
+};
+
+/**
+ * @brief UdpBatchSender - 批量UDP发送器
+ *
+ * 职责：
+ * 1. 管理一个非阻塞的UDP发送socket（可调SO_SNDBUF）
+ * 2. 使用sendmmsg一次系统调用发送整个DatagramBatch
+ * 3. 统计发送错误和EAGAIN次数，不再静默忽略发送失败
+ *
+ * 线程安全：
+ * - Send()由单一发送线程调用
+ * - GetStats()可以被任意线程并发调用（原子计数器）
+ */
+class UdpBatchSender {
+public:
+    UdpBatchSender() : m_socketFd(-1) {}
+
+    ~UdpBatchSender() {
+        Close();
+    }
+
+    // 禁止拷贝
+    UdpBatchSender(const UdpBatchSender&) = delete;
+    UdpBatchSender& operator=(const UdpBatchSender&) = delete;
+
+    /**
+     * @brief 创建发送socket
+     *
+     * @param sendBufferBytes SO_SNDBUF大小（字节），<=0表示使用系统默认值
+     * @param multicastTtl 多播TTL
+     * @return true 如果创建成功
+     */
+    bool Open(int sendBufferBytes = 0, int multicastTtl = 64) {
+        if (m_socketFd >= 0) {
+            return true;
+        }
+
+        m_socketFd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+        if (m_socketFd < 0) {
+            return false;
+        }
+
+        if (setsockopt(m_socketFd, IPPROTO_IP, IP_MULTICAST_TTL,
+                       &multicastTtl, sizeof(multicastTtl)) < 0) {
+            Close();
+            return false;
+        }
+
+        // SO_SNDBUF设置失败不影响功能，保留系统默认值
+        if (sendBufferBytes > 0) {
+            setsockopt(m_socketFd, SOL_SOCKET, SO_SNDBUF,
+                       &sendBufferBytes, sizeof(sendBufferBytes));
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief 关闭发送socket
+     */
+    void Close() {
+        if (m_socketFd >= 0) {
+            close(m_socketFd);
+            m_socketFd = -1;
+        }
+    }
+
+    bool IsOpen() const { return m_socketFd >= 0; }
+
+    /**
+     * @brief 获取内核实际生效的SO_SNDBUF大小
+     *
+     * @return 字节数，socket未打开时返回-1
+     */
+    int GetSendBufferSize() const {
+        if (m_socketFd < 0) {
+            return -1;
+        }
+        int size = 0;
+        socklen_t len = sizeof(size);
+        if (getsockopt(m_socketFd, SOL_SOCKET, SO_SNDBUF, &size, &len) < 0) {
+            return -1;
+        }
+        return size;
+    }
+
+    /**
+     * @brief 批量发送一个批次中的所有数据报
+     *
+     * 发送策略：
+     * - EINTR：重试
+     * - EAGAIN/EWOULDBLOCK：发送缓冲区已满，丢弃本批次剩余数据报（下一轮广播会重发最新状态）
+     * - 其他错误：跳过出错的数据报，继续发送后续数据报
+     *
+     * @param batch 数据报批次
+     * @param dest 目标地址
+     * @return 成功发送的数据报数量
+     */
+    size_t Send(const DatagramBatch& batch, const struct sockaddr_in& dest) {
+        return Send(batch, dest, 0, batch.Size());
+    }
+
+    /**
+     * @brief 批量发送批次中[first, first + count)范围内的数据报（用于分批限速发送）
+     * 
+     * @param batch 数据报批次
+     * @param dest 目标地址
+     * @param first 起始槽位
+     * @param count 数据报数量
+     * @return 成功发送的数据报数量
+     */
+    size_t Send(const DatagramBatch& batch, const struct sockaddr_in& dest,
+                size_t first, size_t count) {
+        if (first >= batch.Size()) {
+            return 0;
+        }
+        count = std::min(count, batch.Size() - first);
+        if (m_socketFd < 0 || count == 0) {
+            return 0;
+        }
+
+        // 构造mmsghdr数组（复用成员vector，iovec直接指向池化缓冲区）
+        if (m_msgs.size() < count) {
+            m_msgs.resize(count);
+            m_iovecs.resize(count);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            m_iovecs[i].iov_base = const_cast<char*>(batch.Data(first + i));
+            m_iovecs[i].iov_len = batch.Length(first + i);
+            std::memset(&m_msgs[i], 0, sizeof(struct mmsghdr));
+            m_msgs[i].msg_hdr.msg_name = const_cast<struct sockaddr_in*>(&dest);
+            m_msgs[i].msg_hdr.msg_namelen = sizeof(dest);
+            m_msgs[i].msg_hdr.msg_iov = &m_iovecs[i];
+            m_msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        size_t sent = 0;     // 已处理的数据报
+        size_t success = 0;  // 成功发送的数据报
+        while (sent < count) {
+            int rc = sendmmsg(m_socketFd, &m_msgs[sent],
+                              static_cast<unsigned int>(count - sent), MSG_DONTWAIT);
+            m_syscalls.fetch_add(1, std::memory_order_relaxed);
+
+            if (rc > 0) {
+                uint64_t bytes = 0;
+                for (size_t i = sent; i < sent + static_cast<size_t>(rc); ++i) {
+                    bytes += m_msgs[i].msg_len;
+                }
+                m_bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+                m_packetsSent.fetch_add(static_cast<uint64_t>(rc), std::memory_order_relaxed);
+                sent += static_cast<size_t>(rc);
+                success += static_cast<size_t>(rc);
+                continue;
+            }
+
+            if (rc < 0 && errno == EINTR) {
+                continue;
+            }
+
+            if (rc < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                m_eagainCount.fetch_add(1, std::memory_order_relaxed);
+                m_packetsDropped.fetch_add(count - sent, std::memory_order_relaxed);
+                break;
+            }
+
+            // 其他错误（如EMSGSIZE）：跳过当前数据报
+            m_sendErrors.fetch_add(1, std::memory_order_relaxed);
+            m_packetsDropped.fetch_add(1, std::memory_order_relaxed);
+            sent++;
+        }
+
+        return success;
+    }
+
+    /**
+     * @brief 获取发送统计快照
+     */
+    UdpSendStats GetStats() const {
+        UdpSendStats stats;
+        stats.packetsSent = m_packetsSent.load(std::memory_order_relaxed);
+        stats.bytesSent = m_bytesSent.load(std::memory_order_relaxed);
+        stats.syscalls = m_syscalls.load(std::memory_order_relaxed);
+        stats.sendErrors = m_sendErrors.load(std::memory_order_relaxed);
+        stats.eagainCount = m_eagainCount.load(std::memory_order_relaxed);
+        stats.packetsDropped = m_packetsDropped.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    int m_socketFd;                                 // 非阻塞UDP socket
+    std::vector<struct mmsghdr> m_msgs;             // sendmmsg消息数组（复用）
+    std::vector<struct iovec> m_iovecs;             // 指向池化缓冲区的iovec（复用）
+
+    // 发送统计
+    std::atomic<uint64_t> m_packetsSent{0};
+    std::atomic<uint64_t> m_bytesSent{0};
+    std::atomic<uint64_t> m_syscalls{0};
+    std::atomic<uint64_t> m_sendErrors{0};
+    std::atomic<uint64_t> m_eagainCount{0};
+    std::atomic<uint64_t> m_packetsDropped{0};
+};
+
+} // namespace zygl::interfaces
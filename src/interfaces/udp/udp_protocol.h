@@ -13,6 +13,16 @@ constexpr const char* MULTICAST_GROUP = "239.255.0.1";  // 多播组地址
 constexpr uint16_t STATE_BROADCAST_PORT = 9001;         // 状态广播端口
 constexpr uint16_t COMMAND_LISTEN_PORT = 9002;          // 命令监听端口
 
+// 资源监控报文命令码（请求和响应相同）
+constexpr uint16_t RESOURCE_MONITOR_COMMAND_CODE = 0xF000;
+
+// 任务查看报文命令码
+constexpr uint16_t TASK_VIEW_REQUEST_CODE = 0xF005;     // 请求
+constexpr uint16_t TASK_VIEW_RESPONSE_CODE = 0xF105;    // 响应
+
+// 单个UDP数据报的最大载荷（IPv4：65535 - 20字节IP头 - 8字节UDP头）
+constexpr size_t MAX_UDP_PAYLOAD = 65507;
+
 // 数据包类型枚举
 enum class PacketType : uint16_t {
     // 状态广播包（服务端 -> 前端）
@@ -24,18 +34,35 @@ enum class PacketType : uint16_t {
     DeployStack = 0x1001,           // 部署业务链命令
     UndeployStack = 0x1002,         // 卸载业务链命令
     AcknowledgeAlert = 0x1003,      // 确认告警命令
+    RetransmitRequest = 0x1004,     // 重传请求（NACK）
+    BatchCommand = 0x1005,          // 批量命令（确认告警/部署/卸载子命令）
     
     // 响应包（服务端 -> 前端）
-    CommandResponse = 0x2001        // 命令响应包
+    CommandResponse = 0x2001,       // 命令响应包
+    BatchCommandResponse = 0x2002   // 批量命令响应包（逐项结果）
+};
+
+// 批量命令的子命令类型
+enum class BatchItemType : uint8_t {
+    AcknowledgeAlert = 1,   // 确认告警（ID为告警ID）
+    DeployStack = 2,        // 部署业务链（ID为标签UUID）
+    UndeployStack = 3       // 卸载业务链（ID为标签UUID）
 };
 
+// 数据包标志（UdpPacketHeader.reserved[0]）
+constexpr uint8_t PACKET_FLAG_COMPRESSED = 0x01;    // 包头之后的载荷为zlib压缩格式（见payload_compressor.h）
+constexpr uint8_t PACKET_FLAG_RETRANSMIT = 0x02;    // 响应NACK单播重传的数据报（序列号和时间戳与原数据报相同）
+
 // 命令结果枚举
 enum class CommandResult : uint16_t {
     Success = 0,            // 成功
     Failed = 1,             // 失败
     InvalidParameter = 2,   // 参数无效
     NotFound = 3,           // 未找到
-    Timeout = 4             // 超时
+    Timeout = 4,            // 超时
+    Accepted = 5,           // 已受理（异步执行，完成后另发最终结果响应）
+    Busy = 6,               // 服务繁忙（执行队列已满，命令未执行）
+    Unattributed = 7        // 已执行，但后端结果中没有该项的业务链路，无法确定该项的结果
 };
 
 #pragma pack(1)
@@ -49,7 +76,7 @@ struct UdpPacketHeader {
     uint32_t sequenceNumber;    // 序列号（用于检测丢包）
     uint64_t timestamp;         // 时间戳（毫秒）
     uint32_t dataLength;        // 数据长度（字节）
-    char reserved[4];           // 保留字段
+    char reserved[4];           // 保留字段（reserved[0]为标志位，见PACKET_FLAG_*）
     
     UdpPacketHeader() 
         : packetType(0), version(1), sequenceNumber(0), 
@@ -109,7 +136,7 @@ struct ResourceMonitorResponsePacket {
     uint8_t taskStates[9][12][8];       // 1=正常，2=异常
     
     ResourceMonitorResponsePacket() 
-        : commandCode(0xF000), responseID(0) {
+        : commandCode(RESOURCE_MONITOR_COMMAND_CODE), responseID(0) {
         std::memset(boardStates, 0, sizeof(boardStates));
         std::memset(taskStates, 0, sizeof(taskStates));
     }
@@ -119,10 +146,101 @@ struct ResourceMonitorResponsePacket {
 static_assert(sizeof(ResourceMonitorResponsePacket) == 1000, 
               "ResourceMonitorResponsePacket大小必须为1000字节");
 
+/**
+ * @brief 资源监控报文请求数据包（前端 -> 服务端）
+ * 
+ * 按照资源监控报文请求协议定义，总计28字节：
+ * - 0-21字节：22字节头部
+ * - 22-23字节：2字节命令码（F000H = 0xF000）
+ * - 24-27字节：4字节请求ID
+ * 
+ * 服务端以单播方式向请求方回复ResourceMonitorResponsePacket，
+ * 响应ID等于请求ID。
+ */
+struct ResourceMonitorRequestPacket {
+    ResourceMonitorHeader header;        // 22字节头部
+    uint16_t commandCode;               // 命令码 F000H (0xF000)
+    uint32_t requestID;                 // 请求ID
+    
+    ResourceMonitorRequestPacket() 
+        : commandCode(RESOURCE_MONITOR_COMMAND_CODE), requestID(0) {
+    }
+};
+
+static_assert(sizeof(ResourceMonitorRequestPacket) == 28, 
+              "ResourceMonitorRequestPacket大小必须为28字节");
+
+/**
+ * @brief 任务查看报文请求数据包（前端 -> 服务端）
+ * 
+ * 按照任务查看报文请求协议定义，总计34字节：
+ * - 0-21字节：22字节头部
+ * - 22-23字节：2字节命令码（F005H = 0xF005）
+ * - 24-27字节：4字节请求ID
+ * - 28-29字节：机箱号（1-9）
+ * - 30-31字节：板卡号（槽位号1-14）
+ * - 32-33字节：任务序号（1-8，板卡任务列表中的顺序）
+ */
+struct TaskViewRequestPacket {
+    ResourceMonitorHeader header;        // 22字节头部
+    uint16_t commandCode;               // 命令码 F005H (0xF005)
+    uint32_t requestID;                 // 请求ID
+    uint16_t chassisNumber;             // 机箱号
+    uint16_t boardNumber;               // 板卡号
+    uint16_t taskIndex;                 // 任务序号
+    
+    TaskViewRequestPacket() 
+        : commandCode(TASK_VIEW_REQUEST_CODE), requestID(0),
+          chassisNumber(0), boardNumber(0), taskIndex(0) {
+    }
+};
+
+static_assert(sizeof(TaskViewRequestPacket) == 34, 
+              "TaskViewRequestPacket大小必须为34字节");
+
+/**
+ * @brief 任务查看报文响应数据包（服务端 -> 前端）
+ * 
+ * 按照任务查看报文响应协议定义，字段顺序排列，总计46字节：
+ * - 0-21字节：22字节头部
+ * - 22-23字节：2字节命令码（F105H = 0xF105）
+ * - 24-27字节：4字节响应ID（等于请求ID）
+ * - 28-29字节：任务状态（0=正常，1=异常）
+ * - 30-33字节：任务ID（取任务ID字符串末尾的数字部分）
+ * - 34-35字节：工作模式（当前未使用，固定为0）
+ * - 36-39字节：板卡IP（网络字节序，同inet_addr）
+ * - 40-41字节：CPU使用率（0-1000千分比）
+ * - 42-45字节：内存使用率（float，百分比）
+ * 
+ * 注：协议文档中板卡IP标注为第36-37字节、长度4，此处按长度依次排列。
+ */
+struct TaskViewResponsePacket {
+    ResourceMonitorHeader header;        // 22字节头部
+    uint16_t commandCode;               // 命令码 F105H (0xF105)
+    uint32_t responseID;                // 响应ID
+    uint16_t taskStatus;                // 任务状态：0=正常，1=异常
+    uint32_t taskID;                    // 任务ID
+    uint16_t workMode;                  // 工作模式
+    uint32_t boardIP;                   // 板卡IP
+    uint16_t cpuUsage;                  // CPU使用率（千分比）
+    float memoryUsage;                  // 内存使用率（百分比）
+    
+    TaskViewResponsePacket() 
+        : commandCode(TASK_VIEW_RESPONSE_CODE), responseID(0), taskStatus(1),
+          taskID(0), workMode(0), boardIP(0), cpuUsage(0), memoryUsage(0.0f) {
+    }
+};
+
+static_assert(sizeof(TaskViewResponsePacket) == 46, 
+              "TaskViewResponsePacket大小必须为46字节");
+
 /**
  * @brief 告警消息数据包
  * 
- * 包含一批告警消息（最多32条）
+ * 包含一批告警消息（结构体容量32条）。
+ * 
+ * 线上采用变长编码：数据包头 + alertCount + 有效告警，
+ * 单个数据报最多MAX_ALERTS_PER_DATAGRAM条，未使用的条目和尾部保留字段不发送。
  */
 struct AlertMessagePacket {
     UdpPacketHeader header;                 // 数据包头
@@ -141,7 +259,10 @@ struct AlertMessagePacket {
 /**
  * @brief 业务链标签数据包
  * 
- * 包含多个业务链的标签信息（最多64个业务链）
+ * 包含多个业务链的标签信息（结构体容量64个业务链）。
+ * 
+ * 线上采用变长编码：数据包头 + stackCount + 有效条目，
+ * 单个数据报最多MAX_STACKS_PER_DATAGRAM个业务链。
  */
 struct StackLabelPacket {
     UdpPacketHeader header;                             // 数据包头
@@ -227,6 +348,73 @@ struct AcknowledgeAlertCommand {
     }
 };
 
+/**
+ * @brief 重传请求命令（NACK）
+ * 
+ * 前端根据告警/标签包的序列号检测到丢包后发送，服务端从重传环中取出原数据报，
+ * 以单播方式重传给请求方（包头reserved[0]置PACKET_FLAG_RETRANSMIT）。
+ * 已超出重传环范围的序列号被忽略，前端等待下一轮广播。
+ * 
+ * 变长：sequenceCount之后只需携带sequenceCount个序列号。不发送命令响应。
+ * 
+ * 防反射放大：一个请求重传的字节数不超过请求数据报大小的RETRANSMIT_AMPLIFICATION_LIMIT倍，
+ * 前端应在序列号之后填充（内容任意，服务端忽略），使请求大小不小于期望重传量的1/3；
+ * 超出的序列号不重传。
+ */
+struct RetransmitRequestCommand {
+    UdpPacketHeader header;             // 数据包头
+    uint32_t sequenceCount;             // 请求重传的序列号数量（最多64）
+    uint32_t sequenceNumbers[64];       // 丢失的序列号
+    
+    RetransmitRequestCommand() 
+        : sequenceCount(0) {
+        header.packetType = static_cast<uint16_t>(PacketType::RetransmitRequest);
+        header.dataLength = sizeof(RetransmitRequestCommand) - sizeof(UdpPacketHeader);
+        std::memset(sequenceNumbers, 0, sizeof(sequenceNumbers));
+    }
+};
+
+/**
+ * @brief 批量命令包头（前端 -> 服务端）
+ * 
+ * 变长：包头之后紧跟itemCount个压缩子命令，每个子命令为
+ *   uint8_t itemType（BatchItemType）+ uint8_t idLength + idLength字节的ID（不含'\0'，最长64）
+ * 例如200个告警确认（36字节UUID）约7.6KB，一个数据报、一次仓储写锁、一个响应。
+ * 
+ * 服务端一次执行全部子命令（告警确认一次批量确认，部署/卸载各一次后端调用），
+ * 以BatchCommandResponseHeader回复逐项结果。包含部署/卸载子命令时先回复Accepted。
+ */
+struct BatchCommandHeader {
+    UdpPacketHeader header;         // 数据包头
+    uint64_t commandID;             // 命令ID（用于响应匹配）
+    char operatorID[64];            // 操作员ID
+    uint16_t itemCount;             // 子命令数量（最多MAX_BATCH_ITEMS）
+    
+    BatchCommandHeader() 
+        : commandID(0), itemCount(0) {
+        header.packetType = static_cast<uint16_t>(PacketType::BatchCommand);
+        std::memset(operatorID, 0, sizeof(operatorID));
+    }
+};
+
+/**
+ * @brief 批量命令响应包头（服务端 -> 前端）
+ * 
+ * 变长：包头之后紧跟itemCount个uint8_t结果（CommandResult），与请求中子命令的顺序一致。
+ */
+struct BatchCommandResponseHeader {
+    UdpPacketHeader header;         // 数据包头
+    uint64_t commandID;             // 命令ID（匹配请求）
+    uint16_t result;                // 整体结果：全部成功为Success，否则为Failed
+    uint16_t itemCount;             // 子命令数量
+    uint16_t successCount;          // 成功的子命令数量
+    
+    BatchCommandResponseHeader() 
+        : commandID(0), result(0), itemCount(0), successCount(0) {
+        header.packetType = static_cast<uint16_t>(PacketType::BatchCommandResponse);
+    }
+};
+
 /**
  * @brief 命令响应包
  * 
@@ -251,5 +439,35 @@ struct CommandResponsePacket {
 
 #pragma pack()
 
+// ==================== 变长编码常量 ====================
+
+// 告警数据包：数据包头 + alertCount 之后紧跟告警数组
+constexpr size_t ALERT_PACKET_PREFIX_SIZE = sizeof(UdpPacketHeader) + sizeof(int32_t);
+constexpr int32_t MAX_ALERTS_PER_DATAGRAM = static_cast<int32_t>(
+    (MAX_UDP_PAYLOAD - ALERT_PACKET_PREFIX_SIZE) / sizeof(domain::Alert));
+
+// 标签数据包：数据包头 + stackCount 之后紧跟业务链条目数组
+constexpr size_t STACK_LABEL_PACKET_PREFIX_SIZE = sizeof(UdpPacketHeader) + sizeof(int32_t);
+constexpr int32_t MAX_STACKS_PER_DATAGRAM = static_cast<int32_t>(
+    (MAX_UDP_PAYLOAD - STACK_LABEL_PACKET_PREFIX_SIZE) / sizeof(StackLabelPacket::StackEntry));
+
+static_assert(MAX_ALERTS_PER_DATAGRAM > 0 && MAX_ALERTS_PER_DATAGRAM <= 32,
+              "单个数据报至少容纳一条告警");
+static_assert(MAX_STACKS_PER_DATAGRAM > 0 && MAX_STACKS_PER_DATAGRAM <= 64,
+              "单个数据报至少容纳一个业务链");
+
+// 重传请求：数据包头 + sequenceCount 之后紧跟序列号数组
+constexpr size_t RETRANSMIT_REQUEST_PREFIX_SIZE = sizeof(UdpPacketHeader) + sizeof(uint32_t);
+constexpr uint32_t MAX_RETRANSMIT_SEQUENCES = 64;
+constexpr size_t RETRANSMIT_AMPLIFICATION_LIMIT = 3;    // 重传字节数 / 请求数据报字节数 上限
+
+// 批量命令：子命令数量和ID长度上限
+constexpr uint16_t MAX_BATCH_ITEMS = 256;
+constexpr size_t MAX_BATCH_ITEM_ID_LENGTH = 64;
+
+// 资源监控响应中响应ID字段的偏移（单播回复时按此拆分iovec，替换响应ID）
+constexpr size_t RESOURCE_MONITOR_ID_OFFSET = sizeof(ResourceMonitorHeader) + sizeof(uint16_t);
+static_assert(RESOURCE_MONITOR_ID_OFFSET == 24, "响应ID位于第24-27字节");
+
 } // namespace zygl::interfaces
 
@@ -208,8 +208,17 @@ class ApplicationBootstrap {
             // 3. 创建API客户端（使用配置）
             m_apiClient = zygl::infrastructure::ServiceFactory::CreateApiClient(
                 m_config.backend.apiUrl,           // 后端API地址
-                m_config.backend.timeoutSeconds    // 超时时间（秒）
+                m_config.backend.timeoutSeconds,   // 超时时间（秒）
+                static_cast<size_t>(std::max(1, m_config.backend.maxConnections))  // 连接池大小
             );
+            if (m_config.backend.deployTimeoutSeconds > 0) {
+                m_apiClient->SetDeployTimeout(m_config.backend.deployTimeoutSeconds);
+            }
+            if (!m_config.backend.capturePath.empty() &&
+                !m_apiClient->StartCapture(m_config.backend.capturePath,
+                    static_cast<size_t>(std::max(1, m_config.backend.captureSegmentMb)) * 1024 * 1024)) {
+                cerr << "    ⚠️  无法开始响应抓取，继续运行" << endl;
+            }
             
             // 4. 创建数据采集服务（使用配置）
             m_dataCollector = zygl::infrastructure::ServiceFactory::CreateDataCollector(
@@ -219,6 +228,17 @@ class ApplicationBootstrap {
                 m_config.dataCollector.intervalSeconds  // 采集间隔
             );
             
+            // 部署/卸载后快速轮询，采集失败时指数退避，Webhook通知后即时刷新
+            m_dataCollector->SetFastPoll(
+                std::chrono::milliseconds(std::max(1, m_config.dataCollector.fastPollIntervalMs)),
+                std::chrono::seconds(std::max(0, m_config.dataCollector.fastPollDurationSeconds)));
+            m_dataCollector->SetMaxBackoff(
+                std::chrono::seconds(std::max(1, m_config.dataCollector.maxBackoffSeconds)));
+            m_dataCollector->SetMinRefreshInterval(
+                std::chrono::milliseconds(std::max(0, m_config.dataCollector.refreshMinIntervalMs)));
+            m_dataCollector->SetCycleHistorySize(
+                static_cast<size_t>(std::max(1, m_config.dataCollector.cycleHistorySize)));
+            
             return true;
         } catch (const exception& e) {
             cerr << "    初始化基础设施层异常: " << e.what() << endl;
@@ -237,12 +257,23 @@ class ApplicationBootstrap {
                 m_stackRepo,
                 m_alertRepo
             );
+            m_monitoringService->SetCollectionStats(m_dataCollector->GetCycleHistory());
             
             // 2. 创建业务链路控制服务（deploy/undeploy）
             m_stackControlService = make_shared<zygl::application::StackControlService>(
                 m_stackRepo,
                 m_apiClient
             );
+            m_stackControlService->SetCoalescingWindow(
+                std::chrono::milliseconds(std::max(0, m_config.backend.coalesceWindowMs)));
+            m_stackControlService->SetBackendSlo(
+                std::chrono::milliseconds(std::max(0, m_config.backend.callSloMs)));
+            
+            // 部署/卸载被后端接受后，数据采集尽快刷新业务链路状态
+            weak_ptr<zygl::infrastructure::DataCollectorService> collector = m_dataCollector;
+            m_stackControlService->SetBackendChangeListener([collector]() {
+                if (auto c = collector.lock()) c->RequestFastPoll();
+            });
             
             // 3. 创建告警服务（告警处理）
             m_alertService = make_shared<zygl::application::AlertService>(
@@ -265,21 +296,104 @@ class ApplicationBootstrap {
             // 1. 创建状态广播器（UDP组播，向前端推送状态，使用配置）
             m_stateBroadcaster = make_shared<zygl::interfaces::StateBroadcaster>(
                 m_monitoringService,
-                m_config.udp.broadcastIntervalMs
+                m_config.udp.broadcastIntervalMs,
+                2000,                               // 告警广播间隔（毫秒）
+                5000,                               // 标签广播间隔（毫秒）
+                m_config.udp.sendBufferBytes        // SO_SNDBUF
             );
             
+            // 告警/标签载荷压缩（需ZLIB编译选项）
+            if (m_config.udp.compressPayloads &&
+                !m_stateBroadcaster->SetCompressionEnabled(true)) {
+                cerr << "    ⚠️  未编译zlib支持（make ZLIB=1），载荷压缩未启用" << endl;
+            }
+            
+            // 多播发送限速（令牌桶，优先级：机箱状态 > 告警 > 标签）
+            m_stateBroadcaster->SetPacing(
+                static_cast<uint32_t>(std::max(0, m_config.udp.pacingPacketsPerSecond)),
+                static_cast<uint64_t>(std::max(0, m_config.udp.pacingBytesPerSecond)));
+            
+            // 仓储提交后立即唤醒广播器（弱引用，避免仓储延长广播器生命周期）
+            weak_ptr<zygl::interfaces::StateBroadcaster> broadcaster = m_stateBroadcaster;
+            m_chassisRepo->AddChangeListener([broadcaster]() {
+                if (auto b = broadcaster.lock()) b->NotifyChassisChanged();
+            });
+            m_alertRepo->AddChangeListener([broadcaster]() {
+                if (auto b = broadcaster.lock()) b->NotifyAlertsChanged();
+            });
+            m_stackRepo->AddChangeListener([broadcaster]() {
+                if (auto b = broadcaster.lock()) b->NotifyStacksChanged();
+            });
+            
             // 2. 创建命令监听器（UDP组播，接收前端命令）
             m_commandListener = make_shared<zygl::interfaces::CommandListener>(
                 m_stackControlService,
-                m_alertService
+                m_alertService,
+                m_stateBroadcaster->GetResourceMonitorCache(),  // F000H请求复用广播的编码报文
+                m_monitoringService,                            // F005H任务查看
+                m_stateBroadcaster->GetRetransmitRing()         // NACK重传最近发送的数据报
             );
             
+            // 命令突发时由更大的接收缓冲区吸收
+            m_commandListener->SetReceiveBufferBytes(m_config.udp.receiveBufferBytes);
+            
+            // 前端重发的命令不重复执行
+            m_commandListener->SetDedupWindow(
+                std::chrono::milliseconds(std::max(0, m_config.udp.commandDedupWindowMs)));
+            
+            // 多个接收分片并行接收和分发命令
+            m_commandListener->SetShardCount(
+                static_cast<size_t>(std::max(1, m_config.udp.commandListenerShards)));
+            
+            // 命令延迟统计，响应超过SLO时输出日志
+            m_commandListener->SetResponseSlo(
+                std::chrono::milliseconds(std::max(0, m_config.udp.commandSloMs)));
+            
+            // 命令响应单播回复发送方，可选多播审计回显
+            m_commandListener->SetAuditEcho(m_config.udp.commandResponseAuditEcho);
+            
+            // 重传请求（NACK）限网段（未配置时不响应）、按发送方和全局限速，避免被用作反射放大器
+            if (!m_commandListener->SetRetransmitLimits(
+                    m_config.udp.retransmitAllowedSubnet,
+                    static_cast<uint32_t>(std::max(0, m_config.udp.retransmitPacketsPerSecond)),
+                    static_cast<uint64_t>(std::max(0, m_config.udp.retransmitBytesPerSecond)),
+                    static_cast<uint32_t>(std::max(0, m_config.udp.retransmitTotalPacketsPerSecond)),
+                    static_cast<uint64_t>(std::max(0, m_config.udp.retransmitTotalBytesPerSecond)))) {
+                cerr << "    重传请求网段配置无效: " << m_config.udp.retransmitAllowedSubnet << endl;
+                return false;
+            }
+            
+            // 命令优先级通道：部署/卸载（批量通道）不阻塞确认告警（交互通道）和只读查询
+            m_commandListener->ConfigureLane(
+                zygl::interfaces::CommandLane::Bulk,
+                static_cast<size_t>(std::max(1, m_config.udp.commandWorkers)),
+                static_cast<size_t>(std::max(1, m_config.udp.commandQueueCapacity)));
+            m_commandListener->ConfigureLane(
+                zygl::interfaces::CommandLane::Interactive,
+                static_cast<size_t>(std::max(1, m_config.udp.ackWorkers)),
+                static_cast<size_t>(std::max(1, m_config.udp.ackQueueCapacity)));
+            
             // 3. 创建Webhook监听器（HTTP服务器，接收后端告警，使用配置）
             m_webhookListener = make_shared<zygl::interfaces::WebhookListener>(
                 m_alertService,
                 m_config.webhook.listenPort
             );
             
+            // 后端推送状态变化/板卡上下线时，数据采集立即刷新对应接口
+            weak_ptr<zygl::infrastructure::DataCollectorService> collector = m_dataCollector;
+            m_webhookListener->SetRefreshHintListener([collector](zygl::interfaces::RefreshTarget target) {
+                if (auto c = collector.lock()) {
+                    c->RequestRefresh(target == zygl::interfaces::RefreshTarget::Boards
+                                          ? zygl::infrastructure::CollectEndpoint::BoardInfo
+                                          : zygl::infrastructure::CollectEndpoint::StackInfo);
+                }
+            });
+            m_webhookListener->SetBoardPresenceListener([collector](const std::string& boardAddress, bool online) {
+                if (auto c = collector.lock()) {
+                    c->QueueBoardPresence(boardAddress, online);
+                }
+            });
+            
             return true;
         } catch (const exception& e) {
             cerr << "    初始化接口层异常: " << e.what() << endl;
@@ -0,0 +1,228 @@
+/**
+ * @file api_replay_server.cpp
+ * @brief 后端API回放服务：用抓取的响应（backend.capture_path）代替后端，离线复现采集负载
+ *
+ * 按抓取时的时间线回放boardinfo/stackinfo响应，采集服务、仓储和状态广播器
+ * 可以在真实的响应形状和变化节奏下做可重复的性能测试。
+ * deploy/undeploy请求直接回复成功（空结果）。
+ *
+ * 用法：
+ *   ./api_replay_server [选项] <抓取文件...>
+ *
+ * 选项：
+ *   --host <地址>     监听地址（默认0.0.0.0）
+ *   --port <端口>     监听端口（默认8080，将backend.api_url指向此端口）
+ *   --speed <倍数>    回放速度：1为原速，10为10倍速；0为逐条模式，每次请求返回该路径的下一条响应（默认1）
+ *   --loop            到达抓取结尾后从头循环（默认停在最后一条）
+ *   --latency         按抓取时的请求耗时延迟响应（按速度缩放）
+ *   --etag            返回ETag并支持If-None-Match（304），模拟支持条件请求的后端
+ *
+ * 示例：
+ *   ./api_replay_server --speed 10 --loop capture/qyw-*.cap
+ */
+
+#include "src/infrastructure/api_client/api_capture.h"
+#include "third_party/httplib.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <thread>
+
+using namespace zygl;
+
+namespace {
+
+struct Options {
+    std::string host = "0.0.0.0";
+    int port = 8080;
+    double speed = 1.0;
+    bool loop = false;
+    bool latency = false;
+    bool etag = false;
+    std::vector<std::string> files;
+};
+
+/**
+ * @brief 单个路径的回放时间线
+ */
+struct PathTimeline {
+    std::vector<int64_t> offsetsUs;                         // 相对于抓取开始的时间
+    std::vector<const infrastructure::CapturedResponse*> responses;
+    std::vector<std::string> etags;
+    std::atomic<size_t> next{0};                            // 逐条模式的下一条
+    std::atomic<uint64_t> served{0};
+    std::atomic<uint64_t> notModified{0};
+};
+
+httplib::Server* g_server = nullptr;
+
+void SignalHandler(int) {
+    if (g_server != nullptr) {
+        g_server->stop();
+    }
+}
+
+void PrintUsage(const char* program) {
+    std::cerr << "用法: " << program
+              << " [--host 地址] [--port 端口] [--speed 倍数] [--loop] [--latency] [--etag] <抓取文件...>\n";
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--host" && hasValue) {
+            options.host = argv[++i];
+        } else if (arg == "--port" && hasValue) {
+            options.port = std::atoi(argv[++i]);
+        } else if (arg == "--speed" && hasValue) {
+            options.speed = std::atof(argv[++i]);
+        } else if (arg == "--loop") {
+            options.loop = true;
+        } else if (arg == "--latency") {
+            options.latency = true;
+        } else if (arg == "--etag") {
+            options.etag = true;
+        } else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        } else {
+            options.files.push_back(arg);
+        }
+    }
+    return !options.files.empty() && options.speed >= 0;
+}
+
+std::string MakeETag(const std::string& body) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : body) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    char buffer[24];
+    std::snprintf(buffer, sizeof(buffer), "\"%016llx\"", static_cast<unsigned long long>(hash));
+    return buffer;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    // 1. 读取所有抓取文件，按抓取时间排序
+    std::vector<infrastructure::CapturedResponse> records;
+    for (const auto& file : options.files) {
+        if (!infrastructure::ApiCaptureReader::Load(file, records)) {
+            return 1;
+        }
+    }
+    if (records.empty()) {
+        std::cerr << "抓取文件中没有记录" << std::endl;
+        return 1;
+    }
+    std::stable_sort(records.begin(), records.end(), [](const auto& a, const auto& b) {
+        return a.capturedAtUs < b.capturedAtUs;
+    });
+
+    // 2. 按路径建立时间线
+    int64_t firstUs = records.front().capturedAtUs;
+    int64_t spanUs = records.back().capturedAtUs - firstUs;
+    std::map<std::string, PathTimeline> timelines;
+    for (const auto& record : records) {
+        PathTimeline& timeline = timelines[record.path];
+        timeline.offsetsUs.push_back(record.capturedAtUs - firstUs);
+        timeline.responses.push_back(&record);
+        timeline.etags.push_back(options.etag ? MakeETag(record.body) : std::string());
+    }
+
+    std::cout << "已加载 " << records.size() << " 条响应，时长 " << spanUs / 1000 << " 毫秒" << std::endl;
+    for (const auto& [path, timeline] : timelines) {
+        std::cout << "  " << path << ": " << timeline.responses.size() << " 条" << std::endl;
+    }
+
+    // 3. 回放
+    httplib::Server server;
+    auto startedAt = std::chrono::steady_clock::now();
+
+    auto selectIndex = [&](PathTimeline& timeline) -> size_t {
+        size_t count = timeline.responses.size();
+        if (options.speed == 0) {
+            size_t index = timeline.next.fetch_add(1, std::memory_order_relaxed);
+            return options.loop ? index % count : std::min(index, count - 1);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startedAt).count();
+        auto position = static_cast<int64_t>(static_cast<double>(elapsed) * options.speed);
+        if (options.loop) {
+            position %= spanUs + 1;
+        }
+        // 该时刻之前最后一条响应（早于该路径第一条时返回第一条）
+        auto it = std::upper_bound(timeline.offsetsUs.begin(), timeline.offsetsUs.end(), position);
+        return it == timeline.offsetsUs.begin() ? 0 : static_cast<size_t>(it - timeline.offsetsUs.begin() - 1);
+    };
+
+    server.Get("/.*", [&](const httplib::Request& req, httplib::Response& res) {
+        auto found = timelines.find(req.path);
+        if (found == timelines.end()) {
+            res.status = 404;
+            return;
+        }
+        PathTimeline& timeline = found->second;
+        size_t index = selectIndex(timeline);
+        const auto& response = *timeline.responses[index];
+
+        if (options.latency) {
+            double scale = options.speed > 0 ? options.speed : 1.0;
+            std::this_thread::sleep_for(std::chrono::microseconds(
+                static_cast<int64_t>(static_cast<double>(response.durationUs) / scale)));
+        }
+
+        if (options.etag) {
+            const std::string& etag = timeline.etags[index];
+            res.set_header("ETag", etag);
+            if (req.get_header_value("If-None-Match") == etag) {
+                timeline.notModified.fetch_add(1, std::memory_order_relaxed);
+                res.status = 304;
+                return;
+            }
+        }
+        timeline.served.fetch_add(1, std::memory_order_relaxed);
+        res.status = response.status;
+        res.set_content(response.body, "application/json");
+    });
+
+    server.Post("/api/v1/external/qyw/(deploy|undeploy)", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content(R"({"code":0,"message":"success","successStackInfos":[],"failureStackInfos":[]})",
+                        "application/json");
+    });
+
+    g_server = &server;
+    signal(SIGINT, SignalHandler);
+    signal(SIGTERM, SignalHandler);
+
+    std::cout << "回放服务监听 " << options.host << ":" << options.port << "（速度 ";
+    if (options.speed == 0) {
+        std::cout << "逐条";
+    } else {
+        std::cout << options.speed << "x";
+    }
+    std::cout << (options.loop ? "，循环" : "") << "），Ctrl+C 结束" << std::endl;
+    if (!server.listen(options.host, options.port)) {
+        std::cerr << "无法监听 " << options.host << ":" << options.port << std::endl;
+        return 1;
+    }
+
+    for (const auto& [path, timeline] : timelines) {
+        std::cout << path << ": 返回 " << timeline.served.load() << " 次，304 "
+                  << timeline.notModified.load() << " 次" << std::endl;
+    }
+    return 0;
+}
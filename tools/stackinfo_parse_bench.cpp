@@ -0,0 +1,235 @@
+/**
+ * @file stackinfo_parse_bench.cpp
+ * @brief stackinfo解析基准：DOM路径（json → StackInfoData → domain::Stack）对比SAX流式解析
+ *
+ * 用法：
+ *   ./stackinfo_parse_bench                     # 生成约8MB的合成响应
+ *   ./stackinfo_parse_bench <stacks> [iters]    # 指定合成响应的业务链路数和迭代次数
+ *   ./stackinfo_parse_bench -f body.json [iters]  # 使用抓取的真实响应体
+ */
+
+#include "src/infrastructure/api_client/qyw_api_client.h"
+#include "src/infrastructure/api_client/stack_info_sax_parser.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace zygl;
+
+namespace {
+
+/**
+ * @brief 生成合成的stackinfo响应体（每个业务链路4个组件，每个组件8个任务）
+ */
+std::string GenerateBody(int stackCount) {
+    nlohmann::json data = nlohmann::json::array();
+    for (int s = 0; s < stackCount; ++s) {
+        nlohmann::json stack;
+        stack["stackName"] = "业务链路-" + std::to_string(s);
+        stack["stackUUID"] = "stack-uuid-" + std::to_string(s);
+        stack["stackDeployStatus"] = 1;
+        stack["stackRunningStatus"] = s % 7 == 0 ? 2 : 1;
+        stack["stackLabelInfos"] = nlohmann::json::array({
+            {{"labelName", "标签-" + std::to_string(s)}, {"labelUUID", "label-uuid-" + std::to_string(s)}},
+            {{"labelName", "公共标签"}, {"labelUUID", "label-uuid-common"}}});
+        nlohmann::json services = nlohmann::json::array();
+        for (int v = 0; v < 4; ++v) {
+            std::string serviceID = std::to_string(s) + "-" + std::to_string(v);
+            nlohmann::json service;
+            service["serviceName"] = "组件-" + serviceID;
+            service["serviceUUID"] = "service-uuid-" + serviceID;
+            service["serviceStatus"] = 2;
+            service["serviceType"] = v == 0 ? 1 : 0;
+            nlohmann::json tasks = nlohmann::json::array();
+            for (int t = 0; t < 8; ++t) {
+                int chassis = (s + t) % 9 + 1;
+                int board = (v * 8 + t) % 14 + 1;
+                tasks.push_back({
+                    {"taskID", "task-" + serviceID + "-" + std::to_string(t)},
+                    {"taskStatus", "running"},
+                    {"cpuCores", 4.0}, {"cpuUsed", 1.25 + t}, {"cpuUsage", 31.25},
+                    {"memorySize", 8192.0}, {"memoryUsed", 2048.5}, {"memoryUsage", 25.0},
+                    {"netReceive", 1024.0 * t}, {"netSent", 512.0 * t}, {"gpuMemUsed", 0.0},
+                    {"chassisName", "机箱-" + std::to_string(chassis)}, {"chassisNumber", chassis},
+                    {"boardName", "板卡-" + std::to_string(board)}, {"boardNumber", board},
+                    {"boardAddress", "192.168." + std::to_string(chassis) + "." + std::to_string(100 + board)}});
+            }
+            service["taskInfos"] = tasks;
+            services.push_back(service);
+        }
+        stack["serviceInfos"] = services;
+        data.push_back(stack);
+    }
+    nlohmann::json body;
+    body["code"] = 0;
+    body["message"] = "success";
+    body["data"] = data;
+    return body.dump();
+}
+
+/**
+ * @brief DOM路径：与改造前的采集流程相同（ParseStackInfoResponse + ConvertToStack）
+ */
+std::optional<std::vector<domain::Stack>> ParseWithDom(const infrastructure::QywApiClient& client,
+                                                        const std::string& body) {
+    auto stackInfos = client.ParseStackInfo(body);
+    if (!stackInfos.has_value()) {
+        return std::nullopt;
+    }
+    std::vector<domain::Stack> stacks;
+    for (const auto& info : stackInfos.value()) {
+        domain::Stack stack(info.stackUUID, info.stackName);
+        stack.SetDeployStatus(static_cast<domain::StackDeployStatus>(info.stackDeployStatus));
+        stack.SetRunningStatus(static_cast<domain::StackRunningStatus>(info.stackRunningStatus));
+        for (const auto& labelInfo : info.stackLabelInfos) {
+            domain::StackLabelInfo label;
+            label.SetLabelName(labelInfo.labelName.c_str());
+            label.SetLabelUUID(labelInfo.labelUUID.c_str());
+            stack.AddLabel(label);
+        }
+        for (const auto& serviceInfo : info.serviceInfos) {
+            domain::Service service(serviceInfo.serviceUUID, serviceInfo.serviceName);
+            service.SetStatus(static_cast<domain::ServiceStatus>(serviceInfo.serviceStatus));
+            service.SetType(static_cast<domain::ServiceType>(serviceInfo.serviceType));
+            for (const auto& taskInfo : serviceInfo.taskInfos) {
+                domain::Task task(taskInfo.taskID);
+                task.SetTaskStatus(taskInfo.taskStatus);
+                task.SetBoardAddress(taskInfo.boardAddress);
+                domain::ResourceUsage resources;
+                resources.cpuCores = taskInfo.cpuCores;
+                resources.cpuUsed = taskInfo.cpuUsed;
+                resources.cpuUsage = taskInfo.cpuUsage;
+                resources.memorySize = taskInfo.memorySize;
+                resources.memoryUsed = taskInfo.memoryUsed;
+                resources.memoryUsage = taskInfo.memoryUsage;
+                resources.netReceive = taskInfo.netReceive;
+                resources.netSent = taskInfo.netSent;
+                resources.gpuMemUsed = taskInfo.gpuMemUsed;
+                task.UpdateResources(resources);
+                domain::LocationInfo location;
+                location.SetChassisName(taskInfo.chassisName.c_str());
+                location.chassisNumber = taskInfo.chassisNumber;
+                location.SetBoardName(taskInfo.boardName.c_str());
+                location.boardNumber = taskInfo.boardNumber;
+                location.SetBoardAddress(taskInfo.boardAddress.c_str());
+                task.UpdateLocation(location);
+                service.AddOrUpdateTask(task);
+            }
+            stack.AddOrUpdateService(service);
+        }
+        stacks.push_back(stack);
+    }
+    return stacks;
+}
+
+/**
+ * @brief 比较两种解析结果（业务链路/组件/任务逐项比对）
+ */
+bool SameResult(const std::vector<domain::Stack>& a, const std::vector<domain::Stack>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        const auto& x = a[i];
+        const auto& y = b[i];
+        if (x.GetStackUUID() != y.GetStackUUID() || x.GetStackName() != y.GetStackName() ||
+            x.GetDeployStatus() != y.GetDeployStatus() || x.GetRunningStatus() != y.GetRunningStatus() ||
+            x.GetLabelCount() != y.GetLabelCount() ||
+            std::memcmp(x.GetLabels().data(), y.GetLabels().data(),
+                        sizeof(domain::StackLabelInfo) * x.GetLabelCount()) != 0 ||
+            x.GetAllServices().size() != y.GetAllServices().size()) {
+            return false;
+        }
+        for (const auto& [uuid, service] : x.GetAllServices()) {
+            auto other = y.FindService(uuid);
+            if (!other.has_value() || other->GetServiceName() != service.GetServiceName() ||
+                other->GetStatus() != service.GetStatus() || other->GetType() != service.GetType() ||
+                other->GetAllTasks().size() != service.GetAllTasks().size()) {
+                return false;
+            }
+            for (const auto& [taskID, task] : service.GetAllTasks()) {
+                auto otherTask = other->FindTask(taskID);
+                if (!otherTask.has_value() || otherTask->GetTaskStatus() != task.GetTaskStatus() ||
+                    otherTask->GetBoardAddress() != task.GetBoardAddress() ||
+                    std::memcmp(&otherTask->GetResources(), &task.GetResources(), sizeof(domain::ResourceUsage)) != 0 ||
+                    std::memcmp(&otherTask->GetLocation(), &task.GetLocation(), sizeof(domain::LocationInfo)) != 0) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+template<typename Fn>
+double MeasureMs(int iterations, Fn&& fn) {
+    double best = 0;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (i == 0 || ms < best) {
+            best = ms;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string body;
+    int iterations = 10;
+
+    if (argc >= 3 && std::string(argv[1]) == "-f") {
+        std::ifstream file(argv[2], std::ios::binary);
+        if (!file) {
+            std::cerr << "无法打开文件: " << argv[2] << std::endl;
+            return 1;
+        }
+        std::ostringstream content;
+        content << file.rdbuf();
+        body = content.str();
+        if (argc >= 4) {
+            iterations = std::atoi(argv[3]);
+        }
+    } else {
+        int stackCount = argc >= 2 ? std::atoi(argv[1]) : 1000;
+        if (argc >= 3) {
+            iterations = std::atoi(argv[2]);
+        }
+        body = GenerateBody(stackCount);
+    }
+    iterations = std::max(iterations, 1);
+
+    infrastructure::QywApiClient client("http://127.0.0.1:1");  // 只用解析接口，不发起请求
+
+    auto domResult = ParseWithDom(client, body);
+    auto saxResult = infrastructure::StackInfoSaxParser::Parse(body);
+    if (!domResult.has_value() || !saxResult.has_value()) {
+        std::cerr << "解析失败" << std::endl;
+        return 1;
+    }
+
+    size_t taskCount = 0;
+    for (const auto& stack : saxResult.value()) {
+        for (const auto& [uuid, service] : stack.GetAllServices()) {
+            taskCount += service.GetTaskCount();
+        }
+    }
+
+    double mb = static_cast<double>(body.size()) / (1024.0 * 1024.0);
+    std::cout << "响应体: " << mb << " MB, 业务链路: " << saxResult->size()
+              << ", 任务: " << taskCount << ", 迭代: " << iterations << "（取最快一次）" << std::endl;
+    std::cout << "结果一致: " << (SameResult(domResult.value(), saxResult.value()) ? "是" : "否") << std::endl;
+
+    double domMs = MeasureMs(iterations, [&]() { ParseWithDom(client, body); });
+    double saxMs = MeasureMs(iterations, [&]() { infrastructure::StackInfoSaxParser::Parse(body); });
+
+    std::cout << "DOM (json → StackInfoData → Stack): " << domMs << " ms, " << mb / (domMs / 1000.0) << " MB/s" << std::endl;
+    std::cout << "SAX (json → Stack):                 " << saxMs << " ms, " << mb / (saxMs / 1000.0) << " MB/s" << std::endl;
+    std::cout << "加速比: " << domMs / saxMs << "x" << std::endl;
+    return 0;
+}